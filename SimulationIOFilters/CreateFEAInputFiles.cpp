@@ -31,6 +31,9 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "SimulationIO/SimulationIOConstants.h"
+#include "SimulationIO/SimulationIOFilters/util/ChunkedTextWriter.hpp"
+#include "SimulationIO/SimulationIOFilters/util/FileCopy.hpp"
+#include "SimulationIO/SimulationIOFilters/util/TextFormatting.hpp"
 #include "SimulationIO/SimulationIOVersion.h"
 
 #define LLU_CAST(arg) static_cast<unsigned long long int>(arg)
@@ -633,8 +636,8 @@ void CreateFEAInputFiles::execute()
     //
     // find total number of Grain Ids
     int32_t maxGrainId = 0;
-    int32_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
-    for(int32_t i = 0; i < totalPoints; i++) // find number of grainIds
+    size_t totalPoints = m->getGeometryAs<ImageGeom>()->getNumberOfElements();
+    for(size_t i = 0; i < totalPoints; i++) // find number of grainIds
     {
       if(m_FeatureIds[i] > maxGrainId)
       {
@@ -649,6 +652,7 @@ void CreateFEAInputFiles::execute()
     {
       QString ss = QObject::tr("Error writing PZFLEX input file '%1'").arg(masterFile);
       setErrorCondition(-1, ss);
+      return;
     }
     //
     fprintf(f, "hedr 0\n");
@@ -764,29 +768,36 @@ void CreateFEAInputFiles::execute()
 
     //
     fprintf(f, "\n");
-    fprintf(f, "matr %d\n", ne_x * ne_y * ne_z);
-    //
-    entriesPerLine = 0;
-    for(int32_t i = 0; i < totalPoints; i++)
-    {
-      if(entriesPerLine != 0) // no space at start
+    fprintf(f, "matr %llu\n", LLU_CAST(totalPoints));
+    //
+    // The matr block is formatted one z-slice per chunk (capped for very large slices) and
+    // the chunks are written in order. The separator only depends on the global index, so
+    // chunks can be formatted independently: 40 entries per line.
+    SimulationIO::ChunkedTextWriter matrWriter(f);
+    matrWriter.setChunkSize(std::min<size_t>(std::max<size_t>(dims[0] * dims[1], 4096), 262144));
+    const int32_t* featureIds = m_FeatureIds;
+    bool written = matrWriter.write(totalPoints, [featureIds](std::string& buffer, size_t start, size_t end) {
+      buffer.resize((end - start) * 12);
+      char* out = &buffer[0];
+      for(size_t i = start; i < end; i++)
       {
-        if((entriesPerLine % 40) != 0u) // 6 per line
+        if(i != 0) // no space at start
         {
-          fprintf(f, " ");
-        }
-        else
-        {
-          fprintf(f, "\n");
-          entriesPerLine = 0;
+          *out++ = ((i % 40) != 0) ? ' ' : '\n';
         }
+        out = SimulationIO::TextFormatting::FormatInt(out, featureIds[i]);
       }
-      fprintf(f, "%d", m_FeatureIds[i]);
-      entriesPerLine++;
-    }
+      buffer.resize(static_cast<size_t>(out - buffer.data()));
+    });
     //
     //
     fclose(f);
+    if(!written)
+    {
+      QString ss = QObject::tr("Error writing PZFLEX input file '%1'").arg(masterFile);
+      setErrorCondition(-1, ss);
+      return;
+    }
     //
     break;
   }
@@ -795,9 +806,8 @@ void CreateFEAInputFiles::execute()
     //
     QString masterFile = m_OutputPath + QDir::separator() + m_OutputFilePrefix + ".in";
     //
-    QFile file;
-    file.setFileName(masterFile);
-    if(!file.open(QIODevice::WriteOnly | QIODevice::Text))
+    FILE* f = fopen(masterFile.toLatin1().data(), "wb");
+    if(nullptr == f)
     {
       QString ss = QObject::tr("BSAM file can not be created: %1").arg(masterFile);
       setErrorCondition(-100, ss);
@@ -805,38 +815,39 @@ void CreateFEAInputFiles::execute()
     }
 
     //
-    file.write("***********************************************\n");
-    file.write("**** BSAM INPUT FILE  generated by DREAM.3D ***\n");
-    file.write("***********************************************\n");
-    file.write("\n");
+    fprintf(f, "***********************************************\n");
+    fprintf(f, "**** BSAM INPUT FILE  generated by DREAM.3D ***\n");
+    fprintf(f, "***********************************************\n");
+    fprintf(f, "\n");
     //
 
+    // The cluster meshes are appended as raw blocks instead of line by line
     for(int32_t i = 0; i < m_NumClusters; i++)
     {
       QString inpFile = m_OutputPath + QDir::separator() + m_OutputFilePrefix + QString("_Cluster") + QString::number(i + 1) + ".ele";
 
-      QFile inStream(inpFile);
-
-      if(!inStream.open(QIODevice::ReadOnly | QIODevice::Text))
+      if(!QFile::exists(inpFile))
       {
+        fclose(f);
         QString ss = QObject::tr("BSAM Input file could not be opened: %1").arg(inpFile);
         setErrorCondition(-100, ss);
         return;
       }
 
-      QByteArray buf;
-
-      file.write("***********************************************\n");
-      while(!inStream.atEnd())
+      fprintf(f, "***********************************************\n");
+      if(!SimulationIO::FileCopy::AppendFileContents(f, inpFile))
       {
-        buf = inStream.readLine();
-        file.write(buf);
+        fclose(f);
+        QString ss = QObject::tr("Error copying BSAM cluster file '%1' into '%2'").arg(inpFile).arg(masterFile);
+        setErrorCondition(-101, ss);
+        return;
       }
 
-      file.write("\n");
+      fprintf(f, "\n");
+      notifyStatusMessage(QObject::tr("Appended cluster %1 of %2").arg(i + 1).arg(m_NumClusters));
     }
 
-    file.close();
+    fclose(f);
     //
     break;
   }
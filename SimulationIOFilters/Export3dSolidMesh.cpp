@@ -4,9 +4,25 @@
 
 #include "Export3dSolidMesh.h"
 
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
 #include <QtCore/QDir>
 #include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QMutex>
 #include <QtCore/QString>
+#include <QtCore/QThread>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/TemplateHelpers.h"
@@ -39,8 +55,597 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "SimulationIO/SimulationIOConstants.h"
+#include "SimulationIO/SimulationIOFilters/util/ChunkedTextWriter.hpp"
+#include "SimulationIO/SimulationIOFilters/util/ExternalJobRunner.h"
+#include "SimulationIO/SimulationIOFilters/util/NetgenVolMerger.h"
+#include "SimulationIO/SimulationIOFilters/util/ScratchStorage.h"
+#include "SimulationIO/SimulationIOFilters/util/SurfaceMeshPreconditioner.h"
+#include "SimulationIO/SimulationIOFilters/util/TextFormatting.hpp"
+#include "SimulationIO/SimulationIOFilters/util/TextParsing.hpp"
+#include "SimulationIO/SimulationIOFilters/util/VolumeMeshReader.h"
 #include "SimulationIO/SimulationIOVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+#ifdef SimulationIO_USE_TETGEN_LIBRARY
+#include <tetgen.h>
+#endif
+
+#ifdef SimulationIO_USE_GMSH_LIBRARY
+#include <gmsh.h>
+#endif
+
+/**
+ * @brief Values of Gmsh's Mesh.Algorithm3D option, in the order of the 3D Algorithm choices of the filter
+ */
+static const int k_GmshAlgorithms3D[] = {1, 4, 7, 10};
+
+/**
+ * @brief GmshMeshSize Returns the Gmsh mesh size (edge length) of a regular tetrahedron with the given volume
+ */
+static double GmshMeshSize(double volume)
+{
+  return std::cbrt(6.0 * std::sqrt(2.0) * volume);
+}
+
+/**
+ * @brief MapTextFile Maps the complete contents of an open file into memory. If the file cannot be mapped
+ * (e.g. it is empty) it is read into buffer instead.
+ * @param file
+ * @param buffer Holds the contents if the file could not be mapped
+ * @param size Set to the number of bytes available at the returned pointer
+ */
+static const char* MapTextFile(QFile& file, QByteArray& buffer, size_t& size)
+{
+  if(file.size() > 0)
+  {
+    uchar* mapped = file.map(0, file.size());
+    if(nullptr != mapped)
+    {
+      size = static_cast<size_t>(file.size());
+      return reinterpret_cast<const char*>(mapped);
+    }
+  }
+  buffer = file.readAll();
+  size = static_cast<size_t>(buffer.size());
+  return buffer.constData();
+}
+
+/**
+ * @brief ReadTetGenHeader Reads the first line of a TetGen .node or .ele file that is not empty or a comment
+ * @param p Start of the file
+ * @param end
+ * @param values Receives up to count numbers; missing trailing numbers are left unchanged
+ * @param count
+ * @return The start of the line after the header, or nullptr if there is no header
+ */
+static const char* ReadTetGenHeader(const char* p, const char* end, int64_t* values, size_t count)
+{
+  while(p < end && SimulationIO::TextParsing::IsEndOfLine(p, end))
+  {
+    p = SimulationIO::TextParsing::NextLine(p, end);
+  }
+  if(p == end || !SimulationIO::TextParsing::ParseInt(p, end, values[0]))
+  {
+    return nullptr;
+  }
+  for(size_t i = 1; i < count; i++)
+  {
+    if(!SimulationIO::TextParsing::ParseInt(p, end, values[i]))
+    {
+      break;
+    }
+  }
+  return SimulationIO::TextParsing::NextLine(p, end);
+}
+
+/**
+ * @brief The ParseTetGenNodesImpl class parses a range of line chunks of a TetGen .node file. Each record is
+ * "<index> <x> <y> <z> [attributes] [boundary marker]"; the coordinates are stored at the record's index.
+ */
+class ParseTetGenNodesImpl
+{
+public:
+  ParseTetGenNodesImpl(const char* data, const size_t* chunkOffsets, int64_t firstNumber, size_t numVerts, float* vertices, size_t* recordCounts, char* errors)
+  : m_Data(data)
+  , m_ChunkOffsets(chunkOffsets)
+  , m_FirstNumber(firstNumber)
+  , m_NumVerts(numVerts)
+  , m_Vertices(vertices)
+  , m_RecordCounts(recordCounts)
+  , m_Errors(errors)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      const char* p = m_Data + m_ChunkOffsets[c];
+      const char* chunkEnd = m_Data + m_ChunkOffsets[c + 1];
+      size_t count = 0;
+      while(p < chunkEnd)
+      {
+        if(SimulationIO::TextParsing::IsEndOfLine(p, chunkEnd))
+        {
+          p = SimulationIO::TextParsing::NextLine(p, chunkEnd);
+          continue;
+        }
+        int64_t index = 0;
+        double xyz[3] = {0.0, 0.0, 0.0};
+        if(!SimulationIO::TextParsing::ParseInt(p, chunkEnd, index) || !SimulationIO::TextParsing::ParseDouble(p, chunkEnd, xyz[0]) || !SimulationIO::TextParsing::ParseDouble(p, chunkEnd, xyz[1]) ||
+           !SimulationIO::TextParsing::ParseDouble(p, chunkEnd, xyz[2]))
+        {
+          m_Errors[c] = 1;
+          break;
+        }
+        index -= m_FirstNumber;
+        if(index < 0 || static_cast<size_t>(index) >= m_NumVerts)
+        {
+          m_Errors[c] = 1;
+          break;
+        }
+        float* vertex = m_Vertices + 3 * index;
+        vertex[0] = static_cast<float>(xyz[0]);
+        vertex[1] = static_cast<float>(xyz[1]);
+        vertex[2] = static_cast<float>(xyz[2]);
+        count++;
+        p = SimulationIO::TextParsing::NextLine(p, chunkEnd);
+      }
+      m_RecordCounts[c] = count;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Data;
+  const size_t* m_ChunkOffsets;
+  int64_t m_FirstNumber;
+  size_t m_NumVerts;
+  float* m_Vertices;
+  size_t* m_RecordCounts;
+  char* m_Errors;
+};
+
+/**
+ * @brief The ParseTetGenElementsImpl class parses a range of line chunks of a TetGen .ele file. Each record is
+ * "<index> <n1> ... <nk> [attributes]"; the first four nodes and the first attribute (the region, i.e. the
+ * feature id) are stored at the record's index.
+ */
+class ParseTetGenElementsImpl
+{
+public:
+  ParseTetGenElementsImpl(const char* data, const size_t* chunkOffsets, int64_t firstNumber, size_t numCells, size_t nodesPerTet, size_t numAttributes, size_t numVerts, MeshIndexType* tets,
+                          int32_t* featureIds, size_t* recordCounts, char* errors)
+  : m_Data(data)
+  , m_ChunkOffsets(chunkOffsets)
+  , m_FirstNumber(firstNumber)
+  , m_NumCells(numCells)
+  , m_NodesPerTet(nodesPerTet)
+  , m_NumAttributes(numAttributes)
+  , m_NumVerts(numVerts)
+  , m_Tets(tets)
+  , m_FeatureIds(featureIds)
+  , m_RecordCounts(recordCounts)
+  , m_Errors(errors)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      const char* p = m_Data + m_ChunkOffsets[c];
+      const char* chunkEnd = m_Data + m_ChunkOffsets[c + 1];
+      size_t count = 0;
+      while(p < chunkEnd)
+      {
+        if(SimulationIO::TextParsing::IsEndOfLine(p, chunkEnd))
+        {
+          p = SimulationIO::TextParsing::NextLine(p, chunkEnd);
+          continue;
+        }
+        if(!parseRecord(p, chunkEnd))
+        {
+          m_Errors[c] = 1;
+          break;
+        }
+        count++;
+        p = SimulationIO::TextParsing::NextLine(p, chunkEnd);
+      }
+      m_RecordCounts[c] = count;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const char* m_Data;
+  const size_t* m_ChunkOffsets;
+  int64_t m_FirstNumber;
+  size_t m_NumCells;
+  size_t m_NodesPerTet;
+  size_t m_NumAttributes;
+  size_t m_NumVerts;
+  MeshIndexType* m_Tets;
+  int32_t* m_FeatureIds;
+  size_t* m_RecordCounts;
+  char* m_Errors;
+
+  bool parseRecord(const char*& p, const char* end) const
+  {
+    int64_t index = 0;
+    if(!SimulationIO::TextParsing::ParseInt(p, end, index))
+    {
+      return false;
+    }
+    index -= m_FirstNumber;
+    if(index < 0 || static_cast<size_t>(index) >= m_NumCells)
+    {
+      return false;
+    }
+    MeshIndexType* tet = m_Tets + 4 * index;
+    for(size_t j = 0; j < m_NodesPerTet; j++)
+    {
+      int64_t node = 0;
+      if(!SimulationIO::TextParsing::ParseInt(p, end, node))
+      {
+        return false;
+      }
+      node -= m_FirstNumber;
+      if(node < 0 || static_cast<size_t>(node) >= m_NumVerts)
+      {
+        return false;
+      }
+      if(j < 4)
+      {
+        tet[j] = static_cast<MeshIndexType>(node);
+      }
+    }
+    double attribute = 0.0;
+    if(m_NumAttributes > 0 && !SimulationIO::TextParsing::ParseDouble(p, end, attribute))
+    {
+      return false;
+    }
+    m_FeatureIds[index] = static_cast<int32_t>(attribute);
+    return true;
+  }
+};
+
+/**
+ * @brief The CopyFeatureDataImpl class copies the phase and the Euler angles of each cell's feature to the cell
+ */
+class CopyFeatureDataImpl
+{
+public:
+  CopyFeatureDataImpl(const int32_t* featureIds, const int32_t* featurePhases, const float* featureEulerAngles, size_t numFeatures, int32_t* phases, float* eulerAngles,
+                      std::atomic<bool>* invalidIds)
+  : m_FeatureIds(featureIds)
+  , m_FeaturePhases(featurePhases)
+  , m_FeatureEulerAngles(featureEulerAngles)
+  , m_NumFeatures(numFeatures)
+  , m_Phases(phases)
+  , m_EulerAngles(eulerAngles)
+  , m_InvalidIds(invalidIds)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    bool invalid = false;
+    for(size_t i = start; i < end; i++)
+    {
+      int32_t feature = m_FeatureIds[i];
+      if(feature < 0 || static_cast<size_t>(feature) >= m_NumFeatures)
+      {
+        invalid = true;
+        m_Phases[i] = 0;
+        m_EulerAngles[3 * i] = 0.0f;
+        m_EulerAngles[3 * i + 1] = 0.0f;
+        m_EulerAngles[3 * i + 2] = 0.0f;
+        continue;
+      }
+      m_Phases[i] = m_FeaturePhases[feature];
+      m_EulerAngles[3 * i] = m_FeatureEulerAngles[3 * feature];
+      m_EulerAngles[3 * i + 1] = m_FeatureEulerAngles[3 * feature + 1];
+      m_EulerAngles[3 * i + 2] = m_FeatureEulerAngles[3 * feature + 2];
+    }
+    if(invalid)
+    {
+      *m_InvalidIds = true;
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_FeatureIds;
+  const int32_t* m_FeaturePhases;
+  const float* m_FeatureEulerAngles;
+  size_t m_NumFeatures;
+  int32_t* m_Phases;
+  float* m_EulerAngles;
+  std::atomic<bool>* m_InvalidIds;
+};
+
+/**
+ * @brief BucketFacesByFeature Lists the faces of every feature in one pass over the face labels (count, prefix sum,
+ * fill). The faces of feature i are faceList[faceOffsets[i], faceOffsets[i + 1]); each entry is 2 * face + side,
+ * where side is 0 if the feature is the first label of the face and 1 if it is the second. Labels outside
+ * [1, numFeatures) are ignored, so feature 0 has no faces.
+ * @param faceLabels Two labels per face
+ * @param numFaces
+ * @param numFeatures Number of features, including feature 0
+ * @param faceOffsets Receives numFeatures + 1 offsets
+ * @param faceList
+ */
+static void BucketFacesByFeature(const int32_t* faceLabels, size_t numFaces, size_t numFeatures, std::vector<size_t>& faceOffsets, std::vector<size_t>& faceList)
+{
+  faceOffsets.assign(numFeatures + 1, 0);
+  for(size_t t = 0; t < 2 * numFaces; t++)
+  {
+    int32_t feature = faceLabels[t];
+    if(feature > 0 && static_cast<size_t>(feature) < numFeatures)
+    {
+      faceOffsets[feature + 1]++;
+    }
+  }
+  std::partial_sum(faceOffsets.begin(), faceOffsets.end(), faceOffsets.begin());
+
+  faceList.resize(faceOffsets.back());
+  std::vector<size_t> cursor(faceOffsets.begin(), faceOffsets.end() - 1);
+  for(size_t t = 0; t < 2 * numFaces; t++)
+  {
+    int32_t feature = faceLabels[t];
+    if(feature > 0 && static_cast<size_t>(feature) < numFeatures)
+    {
+      faceList[cursor[feature]++] = t;
+    }
+  }
+}
+
+/**
+ * @brief BucketFacesByInterface Groups the faces by the pair of features they separate, in one pass after sorting
+ * the distinct pairs. A label outside [1, numFeatures) stands for the outside of the sample (feature 0 in the pair).
+ * Faces with the same feature on both sides are skipped.
+ * @param faceLabels Two labels per face
+ * @param numFaces
+ * @param numFeatures Number of features, including feature 0
+ * @param interfaces Receives the feature pairs, lower feature first, in increasing order
+ * @param faceOffsets Receives interfaces.size() + 1 offsets; the faces of interface k are faceList[faceOffsets[k], faceOffsets[k + 1])
+ * @param faceList Face indices
+ */
+static void BucketFacesByInterface(const int32_t* faceLabels, size_t numFaces, size_t numFeatures, std::vector<std::pair<size_t, size_t>>& interfaces, std::vector<size_t>& faceOffsets,
+                                   std::vector<size_t>& faceList)
+{
+  const size_t noInterface = std::numeric_limits<size_t>::max();
+  auto featureOf = [numFeatures](int32_t label) { return (label > 0 && static_cast<size_t>(label) < numFeatures) ? static_cast<size_t>(label) : 0; };
+
+  // Key of a face: lower feature * numFeatures + higher feature
+  std::vector<size_t> keys(numFaces, noInterface);
+  for(size_t t = 0; t < numFaces; t++)
+  {
+    size_t a = featureOf(faceLabels[2 * t]);
+    size_t b = featureOf(faceLabels[2 * t + 1]);
+    if(a != b)
+    {
+      keys[t] = std::min(a, b) * numFeatures + std::max(a, b);
+    }
+  }
+
+  std::vector<size_t> sortedKeys(keys);
+  std::sort(sortedKeys.begin(), sortedKeys.end());
+  sortedKeys.erase(std::unique(sortedKeys.begin(), sortedKeys.end()), sortedKeys.end());
+  if(!sortedKeys.empty() && sortedKeys.back() == noInterface)
+  {
+    sortedKeys.pop_back();
+  }
+
+  interfaces.resize(sortedKeys.size());
+  for(size_t k = 0; k < sortedKeys.size(); k++)
+  {
+    interfaces[k] = std::make_pair(sortedKeys[k] / numFeatures, sortedKeys[k] % numFeatures);
+  }
+
+  faceOffsets.assign(sortedKeys.size() + 1, 0);
+  for(size_t t = 0; t < numFaces; t++)
+  {
+    if(keys[t] != noInterface)
+    {
+      keys[t] = static_cast<size_t>(std::lower_bound(sortedKeys.begin(), sortedKeys.end(), keys[t]) - sortedKeys.begin());
+      faceOffsets[keys[t] + 1]++;
+    }
+  }
+  std::partial_sum(faceOffsets.begin(), faceOffsets.end(), faceOffsets.begin());
+
+  faceList.resize(faceOffsets.back());
+  std::vector<size_t> cursor(faceOffsets.begin(), faceOffsets.end() - 1);
+  for(size_t t = 0; t < numFaces; t++)
+  {
+    if(keys[t] != noInterface)
+    {
+      faceList[cursor[keys[t]]++] = t;
+    }
+  }
+}
+
+/**
+ * @brief AssignVerticesToInterfaces Gives every vertex of the interface faces to the first interface that uses it,
+ * which is where a mesh file or Gmsh model stores the vertex; the other interfaces only refer to it.
+ * @param triangles
+ * @param numVertices
+ * @param faceOffsets Faces of every interface, see BucketFacesByInterface
+ * @param faceList
+ * @param vertexOffsets Receives the vertices of interface k as vertexList[vertexOffsets[k], vertexOffsets[k + 1]), in increasing order
+ * @param vertexList
+ */
+static void AssignVerticesToInterfaces(const MeshIndexType* triangles, size_t numVertices, const std::vector<size_t>& faceOffsets, const std::vector<size_t>& faceList,
+                                       std::vector<size_t>& vertexOffsets, std::vector<size_t>& vertexList)
+{
+  const size_t noInterface = std::numeric_limits<size_t>::max();
+  size_t numInterfaces = faceOffsets.size() - 1;
+  std::vector<size_t> owner(numVertices, noInterface);
+  vertexOffsets.assign(numInterfaces + 1, 0);
+  for(size_t k = 0; k < numInterfaces; k++)
+  {
+    for(size_t f = faceOffsets[k]; f < faceOffsets[k + 1]; f++)
+    {
+      const MeshIndexType* tri = triangles + 3 * faceList[f];
+      for(size_t c = 0; c < 3; c++)
+      {
+        if(owner[tri[c]] == noInterface)
+        {
+          owner[tri[c]] = k;
+          vertexOffsets[k + 1]++;
+        }
+      }
+    }
+  }
+  std::partial_sum(vertexOffsets.begin(), vertexOffsets.end(), vertexOffsets.begin());
+
+  vertexList.resize(vertexOffsets.back());
+  std::vector<size_t> cursor(vertexOffsets.begin(), vertexOffsets.end() - 1);
+  for(size_t v = 0; v < numVertices; v++)
+  {
+    if(owner[v] != noInterface)
+    {
+      vertexList[cursor[owner[v]]++] = v;
+    }
+  }
+}
+
+/**
+ * @brief GetInterfaceSurfaceLoops Returns the surface loop of every feature: the tags (k + 1) of the interfaces k
+ * that bound it. Feature 0, the outside, gets none.
+ */
+static std::vector<std::vector<int>> GetInterfaceSurfaceLoops(const std::vector<std::pair<size_t, size_t>>& interfaces, size_t numFeatures)
+{
+  std::vector<std::vector<int>> surfaceLoops(numFeatures);
+  for(size_t k = 0; k < interfaces.size(); k++)
+  {
+    if(interfaces[k].first > 0)
+    {
+      surfaceLoops[interfaces[k].first].push_back(static_cast<int>(k + 1));
+    }
+    surfaceLoops[interfaces[k].second].push_back(static_cast<int>(k + 1));
+  }
+  return surfaceLoops;
+}
+
+/**
+ * @brief The WriteFeatureStlImpl class writes the binary STL files of a range of features. The faces of the feature
+ * of file i are faceList[faceOffsets[i], faceOffsets[i + 1]); each entry is 2 * face + side, where side is 1 if the
+ * feature is the second label of the face. Those faces are written with the opposite winding, as Write STL File does.
+ */
+class WriteFeatureStlImpl
+{
+public:
+  WriteFeatureStlImpl(const float* vertices, const MeshIndexType* triangles, const size_t* faceOffsets, const size_t* faceList, const QStringList& files, char* errors)
+  : m_Vertices(vertices)
+  , m_Triangles(triangles)
+  , m_FaceOffsets(faceOffsets)
+  , m_FaceList(faceList)
+  , m_Files(files)
+  , m_Errors(errors)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    // 80 byte header, triangle count, then per triangle normal, three vertices and a 2 byte attribute
+    const size_t headerSize = 84;
+    const size_t triangleSize = 50;
+    std::vector<char> buffer;
+    for(size_t i = start; i < end; i++)
+    {
+      size_t numFaces = m_FaceOffsets[i + 1] - m_FaceOffsets[i];
+      if(numFaces > UINT32_MAX)
+      {
+        m_Errors[i] = 1;
+        continue;
+      }
+      buffer.assign(headerSize + triangleSize * numFaces, 0);
+      std::string header = "DREAM3D Generated For Feature ID " + std::to_string(i + 1);
+      std::memcpy(buffer.data(), header.data(), std::min<size_t>(header.size(), 80));
+      uint32_t count = static_cast<uint32_t>(numFaces);
+      std::memcpy(buffer.data() + 80, &count, sizeof(count));
+
+      char* out = buffer.data() + headerSize;
+      for(size_t f = m_FaceOffsets[i]; f < m_FaceOffsets[i + 1]; f++, out += triangleSize)
+      {
+        const MeshIndexType* tri = m_Triangles + 3 * (m_FaceList[f] >> 1);
+        bool reversed = (m_FaceList[f] & 1) != 0;
+        const float* v0 = m_Vertices + 3 * tri[0];
+        const float* v1 = m_Vertices + 3 * (reversed ? tri[2] : tri[1]);
+        const float* v2 = m_Vertices + 3 * (reversed ? tri[1] : tri[2]);
+
+        float a[3] = {v1[0] - v0[0], v1[1] - v0[1], v1[2] - v0[2]};
+        float b[3] = {v2[0] - v0[0], v2[1] - v0[1], v2[2] - v0[2]};
+        float normal[3] = {a[1] * b[2] - a[2] * b[1], a[2] * b[0] - a[0] * b[2], a[0] * b[1] - a[1] * b[0]};
+        float length = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+        if(length > 0.0f)
+        {
+          normal[0] /= length;
+          normal[1] /= length;
+          normal[2] /= length;
+        }
+
+        std::memcpy(out, normal, 3 * sizeof(float));
+        std::memcpy(out + 12, v0, 3 * sizeof(float));
+        std::memcpy(out + 24, v1, 3 * sizeof(float));
+        std::memcpy(out + 36, v2, 3 * sizeof(float));
+      }
+
+      FILE* f = fopen(m_Files[static_cast<int>(i)].toLocal8Bit().data(), "wb");
+      if(nullptr == f)
+      {
+        m_Errors[i] = 1;
+        continue;
+      }
+      size_t written = fwrite(buffer.data(), 1, buffer.size(), f);
+      if(fclose(f) != 0 || written != buffer.size())
+      {
+        m_Errors[i] = 1;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Vertices;
+  const MeshIndexType* m_Triangles;
+  const size_t* m_FaceOffsets;
+  const size_t* m_FaceList;
+  const QStringList& m_Files;
+  char* m_Errors;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -52,19 +657,32 @@ Export3dSolidMesh::Export3dSolidMesh()
 , m_FeaturePhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Phases)
 , m_FeatureEulerAnglesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::EulerAngles)
 , m_FeatureCentroidArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Centroids)
+, m_FeatureVolumesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellFeatureAttributeMatrixName, SIMPL::FeatureData::Volumes)
 , m_RefineMesh(true)
 , m_MaxRadiusEdgeRatio(2.0f)
 , m_MinDihedralAngle(0.0f)
 , m_LimitTetrahedraVolume(false)
 , m_MaxTetrahedraVolume(0.1f)
 , m_OptimizationLevel(2)
+, m_UseTetGenLibrary(false)
 , m_TetDataContainerName(SIMPL::Defaults::TetrahedralDataContainerName)
 , m_VertexAttributeMatrixName(SIMPL::Defaults::VertexAttributeMatrixName)
 , m_CellAttributeMatrixName(SIMPL::Defaults::CellAttributeMatrixName)
 , m_GmshSTLFileName("")
 , m_MeshFileFormat(0)
+, m_GmshNumThreads(0)
+, m_GmshAlgorithm3D(0)
+, m_UseGmshLibrary(false)
+, m_ConformalMesh(false)
+, m_PreconditionSurfaceMesh(false)
+, m_WeldTolerance(0.0f)
+, m_TargetEdgeLength(0.0f)
+, m_UseFeatureSizeField(false)
+, m_TetrahedraPerFeature(1000)
+, m_OutOfCoreMesh(false)
 , m_NetgenSTLFileName("")
 , m_MeshSize(0)
+, m_MaxNetgenProcesses(0)
 {
   initialize();
 }
@@ -101,22 +719,23 @@ void Export3dSolidMesh::setupFilterParameters()
     choices.push_back("Netgen");
     choices.push_back("Gmsh");
     parameter->setChoices(choices);
-    QStringList linkedProps = {"SurfaceMeshFaceLabelsArrayPath",
-                               "FeaturePhasesArrayPath",
-                               "FeatureCentroidArrayPath",
+    QStringList linkedProps = {"FeatureCentroidArrayPath",
                                "RefineMesh",
                                "MaxRadiusEdgeRatio",
                                "MinDihedralAngle",
                                "OptimizationLevel",
+                               "UseTetGenLibrary",
                                "LimitTetrahedraVolume",
                                "MaxTetrahedraVolume",
-                               "TetDataContainerName",
-                               "VertexAttributeMatrixName",
-                               "CellAttributeMatrixName",
                                "GmshSTLFileName",
                                "NetgenSTLFileName",
                                "MeshSize",
-                               "MeshFileFormat"};
+                               "MaxNetgenProcesses",
+                               "MeshFileFormat",
+                               "GmshNumThreads",
+                               "GmshAlgorithm3D",
+                               "UseGmshLibrary",
+                               "ConformalMesh"};
     parameter->setLinkedProperties(linkedProps);
     parameter->setEditable(false);
     parameter->setCategory(FilterParameter::Parameter);
@@ -126,6 +745,7 @@ void Export3dSolidMesh::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_OUTPUT_PATH_FP("Path", outputPath, FilterParameter::Parameter, Export3dSolidMesh, "*", "*"));
   parameters.push_back(SIMPL_NEW_OUTPUT_PATH_FP("Package Location", PackageLocation, FilterParameter::Parameter, Export3dSolidMesh, "*", "*"));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Run TetGen In Process", UseTetGenLibrary, FilterParameter::Parameter, Export3dSolidMesh, 0));
 
   {
     parameters.push_back(SIMPL_NEW_STRING_FP("STL File Prefix", NetgenSTLFileName, FilterParameter::Parameter, Export3dSolidMesh, 1));
@@ -134,11 +754,13 @@ void Export3dSolidMesh::setupFilterParameters()
   {
     parameters.push_back(SIMPL_NEW_STRING_FP("STL File Prefix", GmshSTLFileName, FilterParameter::Parameter, Export3dSolidMesh, 2));
   }
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Run Gmsh In Process", UseGmshLibrary, FilterParameter::Parameter, Export3dSolidMesh, 2));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Conformal Mesh (Shared Grain Boundaries)", ConformalMesh, FilterParameter::Parameter, Export3dSolidMesh, 2));
 
   parameters.push_back(SeparatorFilterParameter::New("Face Data", FilterParameter::RequiredArray));
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 2, AttributeMatrix::Type::Face, IGeometry::Type::Triangle);
-    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Labels", SurfaceMeshFaceLabelsArrayPath, FilterParameter::RequiredArray, Export3dSolidMesh, req, 0));
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Face Labels", SurfaceMeshFaceLabelsArrayPath, FilterParameter::RequiredArray, Export3dSolidMesh, req));
   }
 
   parameters.push_back(SeparatorFilterParameter::New("Feature Data", FilterParameter::RequiredArray));
@@ -150,13 +772,18 @@ void Export3dSolidMesh::setupFilterParameters()
   {
     DataArraySelectionFilterParameter::RequirementType req =
         DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
-    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Phases", FeaturePhasesArrayPath, FilterParameter::RequiredArray, Export3dSolidMesh, req, 0));
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Phases", FeaturePhasesArrayPath, FilterParameter::RequiredArray, Export3dSolidMesh, req));
   }
   {
     DataArraySelectionFilterParameter::RequirementType req =
         DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Centroids", FeatureCentroidArrayPath, FilterParameter::RequiredArray, Export3dSolidMesh, req, 0));
   }
+  {
+    DataArraySelectionFilterParameter::RequirementType req =
+        DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 1, AttributeMatrix::Type::CellFeature, IGeometry::Type::Image);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Feature Volumes", FeatureVolumesArrayPath, FilterParameter::RequiredArray, Export3dSolidMesh, req));
+  }
 
   {
     ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
@@ -201,6 +828,44 @@ void Export3dSolidMesh::setupFilterParameters()
     parameter->setCategory(FilterParameter::Parameter);
     parameters.push_back(parameter);
   }
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Maximum Concurrent Netgen Processes (0 = one per core)", MaxNetgenProcesses, FilterParameter::Parameter, Export3dSolidMesh, 1));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("3D Algorithm");
+    parameter->setPropertyName("GmshAlgorithm3D");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(Export3dSolidMesh, this, GmshAlgorithm3D));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(Export3dSolidMesh, this, GmshAlgorithm3D));
+
+    QVector<QString> choices;
+    choices.push_back("Delaunay");
+    choices.push_back("Frontal");
+    choices.push_back("MMG3D");
+    choices.push_back("HXT (parallel Delaunay)");
+    parameter->setChoices(choices);
+    parameter->setGroupIndex(2);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
+  parameters.push_back(SIMPL_NEW_INTEGER_FP("Number Of Gmsh Threads (0 = one per core)", GmshNumThreads, FilterParameter::Parameter, Export3dSolidMesh, 2));
+
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Keep Tetrahedral Mesh In Scratch Files (Out Of Core)", OutOfCoreMesh, FilterParameter::Parameter, Export3dSolidMesh));
+
+  {
+    parameters.push_back(SeparatorFilterParameter::New("Feature Size Field", FilterParameter::Parameter));
+    QStringList linkedProps = {"TetrahedraPerFeature", "FeatureVolumesArrayPath"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Size Tetrahedra By Feature Volume", UseFeatureSizeField, FilterParameter::Parameter, Export3dSolidMesh, linkedProps));
+    linkedProps.clear();
+    parameters.push_back(SIMPL_NEW_INTEGER_FP("Tetrahedra Per Feature", TetrahedraPerFeature, FilterParameter::Parameter, Export3dSolidMesh));
+  }
+
+  {
+    parameters.push_back(SeparatorFilterParameter::New("Surface Mesh Preconditioning", FilterParameter::Parameter));
+    QStringList linkedProps = {"WeldTolerance", "TargetEdgeLength"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Precondition Surface Mesh", PreconditionSurfaceMesh, FilterParameter::Parameter, Export3dSolidMesh, linkedProps));
+    linkedProps.clear();
+    parameters.push_back(SIMPL_NEW_FLOAT_FP("Weld Tolerance", WeldTolerance, FilterParameter::Parameter, Export3dSolidMesh));
+    parameters.push_back(SIMPL_NEW_FLOAT_FP("Target Edge Length (0 = no decimation)", TargetEdgeLength, FilterParameter::Parameter, Export3dSolidMesh));
+  }
 
   {
     parameters.push_back(SeparatorFilterParameter::New("Topology Options", FilterParameter::Parameter));
@@ -212,9 +877,9 @@ void Export3dSolidMesh::setupFilterParameters()
 
   {
     parameters.push_back(SeparatorFilterParameter::New("", FilterParameter::CreatedArray));
-    parameters.push_back(SIMPL_NEW_STRING_FP("Data Container Name", TetDataContainerName, FilterParameter::CreatedArray, Export3dSolidMesh, 0));
-    parameters.push_back(SIMPL_NEW_STRING_FP("Vertex Attribute Matrix Name", VertexAttributeMatrixName, FilterParameter::CreatedArray, Export3dSolidMesh, 0));
-    parameters.push_back(SIMPL_NEW_STRING_FP("Cell Attribute Matrix Name", CellAttributeMatrixName, FilterParameter::CreatedArray, Export3dSolidMesh, 0));
+    parameters.push_back(SIMPL_NEW_STRING_FP("Data Container Name", TetDataContainerName, FilterParameter::CreatedArray, Export3dSolidMesh));
+    parameters.push_back(SIMPL_NEW_STRING_FP("Vertex Attribute Matrix Name", VertexAttributeMatrixName, FilterParameter::CreatedArray, Export3dSolidMesh));
+    parameters.push_back(SIMPL_NEW_STRING_FP("Cell Attribute Matrix Name", CellAttributeMatrixName, FilterParameter::CreatedArray, Export3dSolidMesh));
   }
 
   setFilterParameters(parameters);
@@ -229,17 +894,30 @@ void Export3dSolidMesh::readFilterParameters(AbstractFilterParametersReader* rea
   reader->openFilterGroup(this, index);
   setoutputPath(reader->readString("outputPath", getoutputPath()));
   setPackageLocation(reader->readString("PackageLocation", getPackageLocation()));
+  setUseTetGenLibrary(reader->readValue("UseTetGenLibrary", getUseTetGenLibrary()));
   setSurfaceMeshFaceLabelsArrayPath(reader->readDataArrayPath("SurfaceMeshFaceLabelsArrayPath", getSurfaceMeshFaceLabelsArrayPath()));
   setFeatureEulerAnglesArrayPath(reader->readDataArrayPath("FeatureEulerAnglesArrayPath", getFeatureEulerAnglesArrayPath()));
   setFeaturePhasesArrayPath(reader->readDataArrayPath("FeaturePhasesArrayPath", getFeaturePhasesArrayPath()));
   setFeatureCentroidArrayPath(reader->readDataArrayPath("FeatureCentroidArrayPath", getFeatureCentroidArrayPath()));
+  setFeatureVolumesArrayPath(reader->readDataArrayPath("FeatureVolumesArrayPath", getFeatureVolumesArrayPath()));
   setTetDataContainerName(reader->readString("DataContainerName", getTetDataContainerName()));
   setVertexAttributeMatrixName(reader->readString("VertexAttributeMatrixName", getVertexAttributeMatrixName()));
   setCellAttributeMatrixName(reader->readString("CellAttributeMatrixName", getCellAttributeMatrixName()));
   setNetgenSTLFileName(reader->readString("NetgenSTLFileName", getNetgenSTLFileName()));
   setMeshSize(reader->readValue("MeshSize", getMeshSize()));
+  setMaxNetgenProcesses(reader->readValue("MaxNetgenProcesses", getMaxNetgenProcesses()));
   setGmshSTLFileName(reader->readString("GmshSTLFileName", getGmshSTLFileName()));
   setMeshFileFormat(reader->readValue("MeshFileFormat", getMeshFileFormat()));
+  setGmshNumThreads(reader->readValue("GmshNumThreads", getGmshNumThreads()));
+  setGmshAlgorithm3D(reader->readValue("GmshAlgorithm3D", getGmshAlgorithm3D()));
+  setUseGmshLibrary(reader->readValue("UseGmshLibrary", getUseGmshLibrary()));
+  setConformalMesh(reader->readValue("ConformalMesh", getConformalMesh()));
+  setPreconditionSurfaceMesh(reader->readValue("PreconditionSurfaceMesh", getPreconditionSurfaceMesh()));
+  setWeldTolerance(reader->readValue("WeldTolerance", getWeldTolerance()));
+  setTargetEdgeLength(reader->readValue("TargetEdgeLength", getTargetEdgeLength()));
+  setUseFeatureSizeField(reader->readValue("UseFeatureSizeField", getUseFeatureSizeField()));
+  setTetrahedraPerFeature(reader->readValue("TetrahedraPerFeature", getTetrahedraPerFeature()));
+  setOutOfCoreMesh(reader->readValue("OutOfCoreMesh", getOutOfCoreMesh()));
   reader->closeFilterGroup();
 }
 
@@ -251,9 +929,6 @@ void Export3dSolidMesh::dataCheck()
   clearErrorCode();
   clearWarningCode();
 
-  m_Pause = false;
-  m_ProcessPtr.reset();
-
   switch(m_MeshingPackage)
   {
   case 0: // TetGen
@@ -283,110 +958,170 @@ void Export3dSolidMesh::dataCheck()
       setErrorCondition(-1, "Optimization level must be on the interval [0, 10]");
     }
 
-    QVector<DataArrayPath> dataArrayPaths;
-    std::vector<size_t> cDims(1, 1);
-
-    m_FeaturePhasesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getFeaturePhasesArrayPath(),
-                                                                                                             cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_FeaturePhasesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
-    {
-      m_FeaturePhases = m_FeaturePhasesPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
-    if(getErrorCode() >= 0)
+#ifndef SimulationIO_USE_TETGEN_LIBRARY
+    if(getUseTetGenLibrary())
     {
-      dataArrayPaths.push_back(getFeaturePhasesArrayPath());
+      setErrorCondition(-4011, "This build of SimulationIO does not include the TetGen library. Turn off 'Run TetGen In Process' to run the tetgen executable instead");
     }
-
-    cDims[0] = 3;
-    m_FeatureEulerAnglesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureEulerAnglesArrayPath(),
-                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_FeatureEulerAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
-    {
-      m_FeatureEulerAngles = m_FeatureEulerAnglesPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
-    if(getErrorCode() >= 0)
+#endif
+    break;
+  }
+  case 1: // Netgen
+  {
+    if(getMaxNetgenProcesses() < 0)
     {
-      dataArrayPaths.push_back(getFeatureEulerAnglesArrayPath());
+      setErrorCondition(-1, "Maximum number of concurrent Netgen processes must be 0 or greater");
     }
-
-    cDims[0] = 3;
-    m_FeatureCentroidPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureCentroidArrayPath(),
-                                                                                                             cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_FeatureCentroidPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
-    {
-      m_FeatureCentroid = m_FeatureCentroidPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
-    if(getErrorCode() >= 0)
+    break;
+  }
+  case 2: // Gmsh
+  {
+    if(getGmshNumThreads() < 0)
     {
-      dataArrayPaths.push_back(getFeatureCentroidArrayPath());
+      setErrorCondition(-1, "Number of Gmsh threads must be 0 or greater");
     }
-
-    getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrayPaths);
-
-    // Create the output Data Container
-    DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getTetDataContainerName());
-    if(getErrorCode() < 0)
+    if(getGmshAlgorithm3D() < 0 || getGmshAlgorithm3D() >= static_cast<int>(sizeof(k_GmshAlgorithms3D) / sizeof(k_GmshAlgorithms3D[0])))
     {
-      return;
+      setErrorCondition(-1, "Unknown Gmsh 3D algorithm");
     }
 
-    // Create our output Vertex and Cell Matrix objects
-    std::vector<size_t> tDims(1, 0);
-    AttributeMatrix::Pointer vertexAttrMat = m->createNonPrereqAttributeMatrix(this, getVertexAttributeMatrixName(), tDims, AttributeMatrix::Type::Vertex);
-    if(getErrorCode() < 0)
-    {
-      return;
-    }
-    AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(this, getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell);
-    if(getErrorCode() < 0)
+#ifndef SimulationIO_USE_GMSH_LIBRARY
+    if(getUseGmshLibrary())
     {
-      return;
+      setErrorCondition(-4021, "This build of SimulationIO does not include the Gmsh library. Turn off 'Run Gmsh In Process' to run the gmsh executable instead");
     }
-
-    SharedVertexList::Pointer tetvertexPtr = TetrahedralGeom::CreateSharedVertexList(0);
-    TetrahedralGeom::Pointer tetGeomPtr = TetrahedralGeom::CreateGeometry(0, tetvertexPtr, SIMPL::Geometry::TetrahedralGeometry, !getInPreflight());
-    m->setGeometry(tetGeomPtr);
-
+#endif
+    break;
+  }
+  default:
     break;
   }
 
-  case 1:
+  if(getPreconditionSurfaceMesh())
   {
-    QVector<DataArrayPath> dataArrayPaths;
-    std::vector<size_t> cDims(1, 1);
-    cDims[0] = 3;
-    m_FeatureEulerAnglesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureEulerAnglesArrayPath(),
-                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_FeatureEulerAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    if(getWeldTolerance() < 0)
     {
-      m_FeatureEulerAngles = m_FeatureEulerAnglesPtr.lock()->getPointer(0);
-    } /* Now assign the raw pointer to data from the DataArray<T> object */
-    if(getErrorCode() >= 0)
+      setErrorCondition(-1, "Weld tolerance must be 0 or greater");
+    }
+    if(getTargetEdgeLength() < 0)
     {
-      dataArrayPaths.push_back(getFeatureEulerAnglesArrayPath());
+      setErrorCondition(-1, "Target edge length must be 0 or greater");
     }
+  }
 
-    break;
+  // Netgen only has the global Mesh Size
+  bool useFeatureSizeField = getUseFeatureSizeField() && m_MeshingPackage != 1;
+  if(getUseFeatureSizeField() && m_MeshingPackage == 1)
+  {
+    setWarningCondition(-4024, "Netgen does not support a feature size field; 'Size Tetrahedra By Feature Volume' is ignored");
   }
-  case 2:
+  if(useFeatureSizeField && getTetrahedraPerFeature() < 1)
+  {
+    setErrorCondition(-1, "Number of tetrahedra per feature must be at least 1");
+  }
+
+  QVector<DataArrayPath> dataArrayPaths;
+  std::vector<size_t> cDims(1, 1);
+
+  m_FeaturePhasesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getFeaturePhasesArrayPath(),
+                                                                                                           cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_FeaturePhasesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_FeaturePhases = m_FeaturePhasesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(getErrorCode() >= 0)
+  {
+    dataArrayPaths.push_back(getFeaturePhasesArrayPath());
+  }
+
+  cDims[0] = 3;
+  m_FeatureEulerAnglesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureEulerAnglesArrayPath(),
+                                                                                                              cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+  if(nullptr != m_FeatureEulerAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+  {
+    m_FeatureEulerAngles = m_FeatureEulerAnglesPtr.lock()->getPointer(0);
+  } /* Now assign the raw pointer to data from the DataArray<T> object */
+  if(getErrorCode() >= 0)
+  {
+    dataArrayPaths.push_back(getFeatureEulerAnglesArrayPath());
+  }
+
+  getDataContainerArray()->getPrereqGeometryFromDataContainer<TriangleGeom, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
+
+  // The face labels split the surface mesh for Netgen and Gmsh and define the boundary patches for preconditioning
+  if(m_MeshingPackage != 0 || m_PreconditionSurfaceMesh)
+  {
+    cDims[0] = 2;
+    m_SurfaceMeshFaceLabelsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getSurfaceMeshFaceLabelsArrayPath(),
+                                                                                                                   cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_SurfaceMeshFaceLabelsPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_SurfaceMeshFaceLabels = m_SurfaceMeshFaceLabelsPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+  }
+
+  if(m_MeshingPackage == 0)
   {
-    QVector<DataArrayPath> dataArrayPaths;
-    std::vector<size_t> cDims(1, 1);
     cDims[0] = 3;
-    m_FeatureEulerAnglesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureEulerAnglesArrayPath(),
-                                                                                                                cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
-    if(nullptr != m_FeatureEulerAnglesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    m_FeatureCentroidPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureCentroidArrayPath(),
+                                                                                                             cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_FeatureCentroidPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
     {
-      m_FeatureEulerAngles = m_FeatureEulerAnglesPtr.lock()->getPointer(0);
+      m_FeatureCentroid = m_FeatureCentroidPtr.lock()->getPointer(0);
     } /* Now assign the raw pointer to data from the DataArray<T> object */
     if(getErrorCode() >= 0)
     {
-      dataArrayPaths.push_back(getFeatureEulerAnglesArrayPath());
+      dataArrayPaths.push_back(getFeatureCentroidArrayPath());
     }
+  }
 
-    break;
+  if(useFeatureSizeField)
+  {
+    cDims[0] = 1;
+    m_FeatureVolumesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getFeatureVolumesArrayPath(),
+                                                                                                            cDims); /* Assigns the shared_ptr<> to an instance variable that is a weak_ptr<> */
+    if(nullptr != m_FeatureVolumesPtr.lock()) /* Validate the Weak Pointer wraps a non-nullptr pointer to a DataArray<T> object */
+    {
+      m_FeatureVolumes = m_FeatureVolumesPtr.lock()->getPointer(0);
+    } /* Now assign the raw pointer to data from the DataArray<T> object */
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getFeatureVolumesArrayPath());
+    }
+  }
+
+  getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrayPaths);
+
+  // Gmsh's Abaqus output is not read back, so there is no tetrahedral mesh to create (the in process
+  // mode always returns the mesh)
+  if(m_MeshingPackage == 2 && m_MeshFileFormat != 0 && !m_UseGmshLibrary)
+  {
+    return;
+  }
+
+  // Create the output Data Container
+  DataContainer::Pointer m = getDataContainerArray()->createNonPrereqDataContainer<AbstractFilter>(this, getTetDataContainerName());
+  if(getErrorCode() < 0)
+  {
+    return;
+  }
+
+  // Create our output Vertex and Cell Matrix objects
+  std::vector<size_t> tDims(1, 0);
+  AttributeMatrix::Pointer vertexAttrMat = m->createNonPrereqAttributeMatrix(this, getVertexAttributeMatrixName(), tDims, AttributeMatrix::Type::Vertex);
+  if(getErrorCode() < 0)
+  {
+    return;
   }
+  AttributeMatrix::Pointer cellAttrMat = m->createNonPrereqAttributeMatrix(this, getCellAttributeMatrixName(), tDims, AttributeMatrix::Type::Cell);
+  if(getErrorCode() < 0)
+  {
+    return;
   }
+
+  SharedVertexList::Pointer tetvertexPtr = TetrahedralGeom::CreateSharedVertexList(0);
+  TetrahedralGeom::Pointer tetGeomPtr = TetrahedralGeom::CreateGeometry(0, tetvertexPtr, SIMPL::Geometry::TetrahedralGeometry, !getInPreflight());
+  m->setGeometry(tetGeomPtr);
 }
 
 // -----------------------------------------------------------------------------
@@ -415,21 +1150,37 @@ void Export3dSolidMesh::execute()
     return;
   }
 
-  QDir dir;
-  if(!dir.mkpath(m_outputPath))
+  // Every file and process of the run uses absolute paths below this directory, and the current directory of the
+  // process is never changed, so several instances of the filter can run at the same time
+  m_WorkingDirectory = QDir(m_outputPath).absolutePath();
+  if(!QDir().mkpath(m_WorkingDirectory))
   {
-    QString ss = QObject::tr("Output directory does not exist '%1'").arg(m_outputPath);
+    QString ss = QObject::tr("Output directory does not exist '%1'").arg(m_WorkingDirectory);
     setErrorCondition(-1, ss);
     return;
   }
 
+  m_ScratchStorage.reset();
+  if(m_OutOfCoreMesh)
+  {
+    m_ScratchStorage = std::make_shared<SimulationIO::ScratchStorage>(m_WorkingDirectory);
+  }
+
+  DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
+  TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
+
+  // The preconditioned copy replaces the surface mesh and its face labels for the rest of execute()
+  Int32ArrayType::Pointer preconditionedFaceLabels;
+  if(m_PreconditionSurfaceMesh)
+  {
+    triangleGeom = preconditionSurfaceMesh(triangleGeom.get(), preconditionedFaceLabels);
+    m_SurfaceMeshFaceLabels = preconditionedFaceLabels->getPointer(0);
+  }
+
   switch(m_MeshingPackage)
   {
   case 0: // TetGen
   {
-    DataContainer::Pointer sm = getDataContainerArray()->getDataContainer(getSurfaceMeshFaceLabelsArrayPath().getDataContainerName());
-    TriangleGeom::Pointer triangleGeom = sm->getGeometryAs<TriangleGeom>();
-
     MeshIndexType numNodes = triangleGeom->getNumberOfVertices();
     float* nodes = triangleGeom->getVertexPointer(0);
 
@@ -438,101 +1189,205 @@ void Export3dSolidMesh::execute()
 
     size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
 
+    DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getTetDataContainerName());
+    AttributeMatrix::Pointer vertexAttrMat = m->getAttributeMatrix(getVertexAttributeMatrixName());
+    AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
+
+    if(m_UseTetGenLibrary)
+    {
+      runTetGenLibrary(triangleGeom.get(), numfeatures, m_FeatureCentroid, m.get(), vertexAttrMat.get(), cellAttrMat.get());
+      break;
+    }
+
     // creating TetGen input file
-    QString tetgenInpFile = m_outputPath + QDir::separator() + "tetgenInp.smesh";
+    QString tetgenInpFile = m_WorkingDirectory + QDir::separator() + "tetgenInp.smesh";
 
     createTetgenInpFile(tetgenInpFile, numNodes, nodes, numTri, triangles, numfeatures, m_FeatureCentroid);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
 
     // running TetGen
     runPackage(tetgenInpFile, tetgenInpFile);
+    if(getErrorCode() < 0 || getCancel())
+    {
+      return;
+    }
 
-    DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getTetDataContainerName());
-    AttributeMatrix::Pointer vertexAttrMat = m->getAttributeMatrix(getVertexAttributeMatrixName());
-    AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
-
-    QString tetgenEleFile = m_outputPath + QDir::separator() + "tetgenInp.1.ele";
-    QString tetgenNodeFile = m_outputPath + QDir::separator() + "tetgenInp.1.node";
+    QString tetgenEleFile = m_WorkingDirectory + QDir::separator() + "tetgenInp.1.ele";
+    QString tetgenNodeFile = m_WorkingDirectory + QDir::separator() + "tetgenInp.1.node";
     scanTetGenFile(tetgenEleFile, tetgenNodeFile, m.get(), vertexAttrMat.get(), cellAttrMat.get());
 
     break;
   }
   case 1: // Netgen
   {
-
     size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
-    QString netgenMeshFile;
-    QString mergedMesh = m_NetgenSTLFileName + "MergedMesh.vol";
-    QString workPath = m_outputPath;
-    QString asciiSTLFile;
-    QString binSTLFile;
+    QDir workDir(m_WorkingDirectory);
+    QString mergedMesh = workDir.absoluteFilePath(m_NetgenSTLFileName + "MergedMesh.vol");
+    QStringList binSTLFiles;
+    QStringList netgenMeshFiles;
 
     for(size_t i = 1; i < numfeatures; i++)
     {
-      asciiSTLFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(i) + ".stl";
-      binSTLFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(i) + ".stlb";
-
-      QDir::setCurrent(workPath);
-      QFile::copy(asciiSTLFile, binSTLFile);
+      QString featureName = m_NetgenSTLFileName + QString("Feature_") + QString::number(i);
+      binSTLFiles << workDir.absoluteFilePath(featureName + ".stlb");
+      netgenMeshFiles << workDir.absoluteFilePath(featureName + ".vol");
     }
 
-    for(size_t i = 1; i < numfeatures; i++)
-    {
-
-      binSTLFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(i) + ".stlb";
-      netgenMeshFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(i) + ".vol";
+    // Binary STL input of every feature, straight from the surface mesh
+    writeFeatureStlFiles(triangleGeom.get(), binSTLFiles);
 
-      // running Netgen
-      runPackage(binSTLFile, netgenMeshFile);
+    // running Netgen, several features at once
+    if(getErrorCode() >= 0)
+    {
+      runNetgenJobs(binSTLFiles, netgenMeshFiles);
     }
 
-    netgenMeshFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(1) + ".vol";
-    QDir::setCurrent(workPath);
-    QFile::copy(netgenMeshFile, mergedMesh);
-
-    if(numfeatures > 2)
+    if(getErrorCode() >= 0 && !getCancel() && !netgenMeshFiles.isEmpty())
     {
-      for(size_t i = 2; i < numfeatures; i++)
+      // Merging all feature meshes in one pass; volume elements of feature i get material number i
+      notifyStatusMessage("Merging individual volume meshes");
+      SimulationIO::NetgenVolMerger merger;
+      if(!merger.merge(netgenMeshFiles, mergedMesh))
       {
-
-        netgenMeshFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(i) + ".vol";
-
-        // running Netgen
-        mergeMesh(mergedMesh, netgenMeshFile);
+        setErrorCondition(-4016, merger.getErrorMessage());
+      }
+      else if(!merger.getDroppedSections().isEmpty())
+      {
+        QString ss = QObject::tr("These sections of the Netgen meshes were not carried over into the merged mesh: %1").arg(merger.getDroppedSections().join(", "));
+        setWarningCondition(-4017, ss);
       }
     }
 
-    for(size_t i = 1; i < numfeatures; i++)
+    for(const QString& binSTLFile : binSTLFiles)
     {
-      binSTLFile = m_NetgenSTLFileName + QString("Feature_") + QString::number(i) + ".stlb";
-
-      QDir::setCurrent(workPath);
       QFile::remove(binSTLFile);
     }
 
+    if(getErrorCode() >= 0 && !getCancel() && !netgenMeshFiles.isEmpty())
+    {
+      DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getTetDataContainerName());
+      scanVolumeMesh(mergedMesh, m.get(), m->getAttributeMatrix(getVertexAttributeMatrixName()).get(), m->getAttributeMatrix(getCellAttributeMatrixName()).get());
+    }
+
     break;
   }
   case 2: // Gmsh
   {
-
     size_t numfeatures = m_FeatureEulerAnglesPtr.lock()->getNumberOfTuples();
+
+    if(m_UseGmshLibrary)
+    {
+      DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getTetDataContainerName());
+      runGmshLibrary(triangleGeom.get(), numfeatures, m.get(), m->getAttributeMatrix(getVertexAttributeMatrixName()).get(),
+                     m->getAttributeMatrix(getCellAttributeMatrixName()).get());
+      break;
+    }
+
+    QDir workDir(m_WorkingDirectory);
+    QStringList stlFiles;
+    QString interfaceMeshFile;
+    std::vector<std::vector<int>> surfaceLoops;
+    if(m_ConformalMesh)
+    {
+      // One file with every grain boundary as a surface, shared by the volumes on both sides
+      std::vector<std::pair<size_t, size_t>> interfaces;
+      std::vector<size_t> faceOffsets;
+      std::vector<size_t> faceList;
+      BucketFacesByInterface(m_SurfaceMeshFaceLabels, triangleGeom->getNumberOfTris(), numfeatures, interfaces, faceOffsets, faceList);
+      surfaceLoops = GetInterfaceSurfaceLoops(interfaces, numfeatures);
+      interfaceMeshFile = workDir.absoluteFilePath(m_GmshSTLFileName + "Interfaces.msh");
+      writeInterfaceMeshFile(triangleGeom.get(), faceOffsets, faceList, interfaceMeshFile);
+    }
+    else
+    {
+      // STL file of every feature, straight from the surface mesh
+      for(size_t i = 1; i < numfeatures; i++)
+      {
+        stlFiles << workDir.absoluteFilePath(m_GmshSTLFileName + QString("Feature_") + QString::number(i) + ".stl");
+      }
+      writeFeatureStlFiles(triangleGeom.get(), stlFiles);
+    }
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+
     // creating Gmsh .geo file
-    QString gmshGeoFile = m_outputPath + QDir::separator() + "gmsh.geo";
-    QString STLFileNamewExt;
+    QString gmshGeoFile = m_WorkingDirectory + QDir::separator() + "gmsh.geo";
 
     FILE* f1 = fopen(gmshGeoFile.toLatin1().data(), "wb");
     if(nullptr == f1)
     {
       QString ss = QObject::tr("Error creating Gmsh geo file '%1'").arg(gmshGeoFile);
       setErrorCondition(-1, ss);
+      return;
     }
 
-    for(size_t i = 1; i < numfeatures; i++)
+    // Meshing options first, so that running gmsh.geo by hand gives the same mesh
+    fprintf(f1, "General.NumThreads = %d;\n", getGmshThreadCount());
+    fprintf(f1, "Mesh.Algorithm3D = %d;\n", k_GmshAlgorithms3D[m_GmshAlgorithm3D]);
+
+    std::vector<size_t> volumes;
+    // Gmsh resolves the merged file names against the directory of gmsh.geo, not its working directory
+    if(m_ConformalMesh)
+    {
+      fprintf(f1, "Merge \"%s\";\n", QFileInfo(interfaceMeshFile).fileName().toLatin1().data());
+      for(size_t i = 1; i < numfeatures; i++)
+      {
+        if(surfaceLoops[i].empty())
+        {
+          continue;
+        }
+        QStringList surfaces;
+        for(int surface : surfaceLoops[i])
+        {
+          surfaces << QString::number(surface);
+        }
+        fprintf(f1, "Surface Loop(%zu) = {%s};\n", i, surfaces.join(", ").toLatin1().data());
+        fprintf(f1, "Volume(%zu) = {%zu};\n", i, i);
+        volumes.push_back(i);
+      }
+    }
+    else
     {
+      for(size_t i = 1; i < numfeatures; i++)
+      {
+        QString STLFileNamewExt = QFileInfo(stlFiles[static_cast<int>(i - 1)]).fileName();
+        fprintf(f1, "Merge \"%s\";\n", STLFileNamewExt.toLatin1().data());
+        fprintf(f1, "Surface Loop(%zu) = {%zu};\n", i, i);
+        fprintf(f1, "Volume(%zu) = {%zu};\n", i, i);
+        volumes.push_back(i);
+      }
+    }
 
-      STLFileNamewExt = m_GmshSTLFileName + QString("Feature_") + QString::number(i) + ".stl";
-      fprintf(f1, "Merge \"%s\";\n", STLFileNamewExt.toLatin1().data());
-      fprintf(f1, "Surface Loop(%zu) = {%zu};\n", i, i);
-      fprintf(f1, "Volume(%zu) = {%zu};\n", i, i);
+    if(m_UseFeatureSizeField)
+    {
+      // Field i holds the mesh size of volume i; the background field is their minimum
+      std::vector<double> maxVolumes = getFeatureMaxVolumes(numfeatures);
+      QStringList fields;
+      fprintf(f1, "Mesh.MeshSizeExtendFromBoundary = 0;\n");
+      fprintf(f1, "Mesh.MeshSizeFromPoints = 0;\n");
+      for(size_t i : volumes)
+      {
+        if(maxVolumes[i] <= 0.0)
+        {
+          continue;
+        }
+        fprintf(f1, "Field[%zu] = Constant;\n", i);
+        fprintf(f1, "Field[%zu].VIn = %.9g;\n", i, GmshMeshSize(maxVolumes[i]));
+        fprintf(f1, "Field[%zu].VOut = 1e22;\n", i);
+        fprintf(f1, "Field[%zu].VolumesList = {%zu};\n", i, i);
+        fields << QString::number(i);
+      }
+      if(!fields.isEmpty())
+      {
+        fprintf(f1, "Field[%zu] = Min;\n", numfeatures);
+        fprintf(f1, "Field[%zu].FieldsList = {%s};\n", numfeatures, fields.join(", ").toLatin1().data());
+        fprintf(f1, "Background Field = %zu;\n", numfeatures);
+      }
     }
 
     fclose(f1);
@@ -540,6 +1395,14 @@ void Export3dSolidMesh::execute()
     // running Gmsh
     runPackage(gmshGeoFile, gmshGeoFile);
 
+    // Gmsh writes gmsh.msh next to gmsh.geo; volume i of the .geo file is feature i
+    if(m_MeshFileFormat == 0 && getErrorCode() >= 0 && !getCancel())
+    {
+      DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getTetDataContainerName());
+      QString gmshMeshFile = m_WorkingDirectory + QDir::separator() + "gmsh.msh";
+      scanVolumeMesh(gmshMeshFile, m.get(), m->getAttributeMatrix(getVertexAttributeMatrixName()).get(), m->getAttributeMatrix(getCellAttributeMatrixName()).get());
+    }
+
     break;
   }
   }
@@ -550,6 +1413,44 @@ void Export3dSolidMesh::execute()
   }
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+TriangleGeom::Pointer Export3dSolidMesh::preconditionSurfaceMesh(TriangleGeom* triangleGeom, Int32ArrayType::Pointer& faceLabels)
+{
+  notifyStatusMessage("Preconditioning surface mesh");
+
+  SimulationIO::SurfaceMeshPreconditioner preconditioner;
+  preconditioner.setWeldTolerance(m_WeldTolerance);
+  preconditioner.setTargetEdgeLength(m_TargetEdgeLength);
+  preconditioner.run(triangleGeom->getVertexPointer(0), triangleGeom->getNumberOfVertices(), triangleGeom->getTriPointer(0), m_SurfaceMeshFaceLabels, triangleGeom->getNumberOfTris());
+
+  const std::vector<float>& vertices = preconditioner.getVertices();
+  const std::vector<MeshIndexType>& triangles = preconditioner.getTriangles();
+  const std::vector<int32_t>& labels = preconditioner.getFaceLabels();
+  size_t numVerts = vertices.size() / 3;
+  size_t numTris = triangles.size() / 3;
+
+  SharedVertexList::Pointer vertexPtr = TriangleGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts), true);
+  std::copy(vertices.begin(), vertices.end(), vertexPtr->getPointer(0));
+  TriangleGeom::Pointer preconditioned = TriangleGeom::CreateGeometry(static_cast<int64_t>(numTris), vertexPtr, SIMPL::Geometry::TriangleGeometry, true);
+  std::copy(triangles.begin(), triangles.end(), preconditioned->getTriPointer(0));
+
+  std::vector<size_t> cDims(1, 2);
+  faceLabels = Int32ArrayType::CreateArray(numTris, cDims, SIMPL::FaceData::SurfaceMeshFaceLabels, true);
+  std::copy(labels.begin(), labels.end(), faceLabels->getPointer(0));
+
+  QString ss = QObject::tr("Preconditioned surface mesh: %1 vertices welded, %2 triangles removed, %3 edges collapsed, %4 of %5 triangles left")
+                   .arg(preconditioner.getNumberOfWeldedVertices())
+                   .arg(preconditioner.getNumberOfRemovedTriangles())
+                   .arg(preconditioner.getNumberOfCollapsedEdges())
+                   .arg(numTris)
+                   .arg(triangleGeom->getNumberOfTris());
+  notifyStatusMessage(ss);
+
+  return preconditioned;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -560,33 +1461,237 @@ void Export3dSolidMesh::createTetgenInpFile(const QString& file, MeshIndexType n
   {
     QString ss = QObject::tr("Error writing tetGen input file '%1'").arg(file);
     setErrorCondition(-1, ss);
+    return;
   }
 
+  // Coordinates are written with the shortest text that reads back as the same float, so TetGen sees exactly
+  // the surface mesh (fixed decimals collapse nearby vertices of finely resolved meshes into degenerate facets).
+  // The node and facet lists are formatted in parallel chunks.
+  SimulationIO::ChunkedTextWriter writer(f1);
+  writer.setChunkSize(8192);
+
   fprintf(f1, "# Part 1 - node list\n");
   fprintf(f1, "%lld 3 0 0\n", static_cast<long long int>(numNodes));
-  for(MeshIndexType k = 0; k < numNodes; k++)
-  {
-    fprintf(f1, "%lld %.3f %.3f %.3f\n", static_cast<long long int>(k + 1), nodes[k * 3], nodes[k * 3 + 1], nodes[k * 3 + 2]);
-  }
+  bool written = writer.write(numNodes, [nodes](std::string& buffer, size_t start, size_t end) {
+    const size_t k_MaxNodeLineSize = 72; // index, three shortest round-trip floats (at most 15 characters each)
+    buffer.resize((end - start) * k_MaxNodeLineSize + SimulationIO::TextFormatting::k_MaxCharsPerValue);
+    char* out = &buffer[0];
+    for(size_t k = start; k < end; k++)
+    {
+      out = SimulationIO::TextFormatting::FormatUInt(out, k + 1);
+      for(size_t c = 0; c < 3; c++)
+      {
+        *out++ = ' ';
+        out = SimulationIO::TextFormatting::FormatRoundTrip(out, nodes[k * 3 + c]);
+      }
+      *out++ = '\n';
+    }
+    buffer.resize(static_cast<size_t>(out - buffer.data()));
+  });
 
   fprintf(f1, "# Part 2 - element list\n");
   fprintf(f1, "%lld 0\n", static_cast<long long int>(numTri));
-  for(MeshIndexType k = 0; k < numTri; k++)
-  {
-    fprintf(f1, "3 %lld %lld %lld\n", static_cast<long long int>(triangles[k * 3] + 1), static_cast<long long int>(triangles[k * 3 + 1] + 1), static_cast<long long int>(triangles[k * 3 + 2] + 1));
-  }
+  written = written && writer.write(numTri, [triangles](std::string& buffer, size_t start, size_t end) {
+    const size_t k_MaxFacetLineSize = 68;
+    buffer.resize((end - start) * k_MaxFacetLineSize);
+    char* out = &buffer[0];
+    for(size_t k = start; k < end; k++)
+    {
+      *out++ = '3';
+      for(size_t c = 0; c < 3; c++)
+      {
+        *out++ = ' ';
+        out = SimulationIO::TextFormatting::FormatUInt(out, triangles[k * 3 + c] + 1);
+      }
+      *out++ = '\n';
+    }
+    buffer.resize(static_cast<size_t>(out - buffer.data()));
+  });
 
   fprintf(f1, "# Part 3 - hole list\n");
   fprintf(f1, "0\n");
 
+  // region: number x y z attribute [maximum volume]
   fprintf(f1, "# Part 4 - region list\n");
   fprintf(f1, "%zu 0\n", numfeatures - 1);
+  std::vector<double> maxVolumes = m_UseFeatureSizeField ? getFeatureMaxVolumes(numfeatures) : std::vector<double>();
+  char line[6 * SimulationIO::TextFormatting::k_MaxCharsPerValue];
   for(size_t i = 1; i < numfeatures; i++)
   {
-    fprintf(f1, "%zu %.3f %.3f %.3f %zu\n", i, centroid[i * 3], centroid[i * 3 + 1], centroid[i * 3 + 2], i);
+    char* out = SimulationIO::TextFormatting::FormatUInt(line, i);
+    for(size_t c = 0; c < 3; c++)
+    {
+      *out++ = ' ';
+      out = SimulationIO::TextFormatting::FormatRoundTrip(out, centroid[i * 3 + c]);
+    }
+    *out++ = ' ';
+    out = SimulationIO::TextFormatting::FormatUInt(out, i);
+    if(!maxVolumes.empty())
+    {
+      *out++ = ' ';
+      out = SimulationIO::TextFormatting::FormatRoundTrip(out, static_cast<float>(maxVolumes[i]));
+    }
+    *out++ = '\n';
+    fwrite(line, 1, static_cast<size_t>(out - line), f1);
+  }
+
+  if(fclose(f1) != 0 || !written)
+  {
+    QString ss = QObject::tr("Error writing tetGen input file '%1'").arg(file);
+    setErrorCondition(-1, ss);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Export3dSolidMesh::writeFeatureStlFiles(TriangleGeom* triangleGeom, const QStringList& stlFiles)
+{
+  notifyStatusMessage("Writing feature STL files");
+
+  // Feature i is written to stlFiles[i - 1]
+  size_t numFiles = static_cast<size_t>(stlFiles.size());
+  std::vector<size_t> faceOffsets;
+  std::vector<size_t> faceList;
+  BucketFacesByFeature(m_SurfaceMeshFaceLabels, triangleGeom->getNumberOfTris(), numFiles + 1, faceOffsets, faceList);
+
+  // faceOffsets[1] is where feature 1 starts, so file i uses faceOffsets[i + 1, i + 2]
+  std::vector<char> errors(numFiles, 0);
+  WriteFeatureStlImpl impl(triangleGeom->getVertexPointer(0), triangleGeom->getTriPointer(0), faceOffsets.data() + 1, faceList.data(), stlFiles, errors.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numFiles), impl, tbb::auto_partitioner());
+#else
+  impl.convert(0, numFiles);
+#endif
+
+  for(size_t i = 0; i < numFiles; i++)
+  {
+    if(errors[i] != 0)
+    {
+      QString ss = QObject::tr("Error writing STL file '%1'").arg(stlFiles[static_cast<int>(i)]);
+      setErrorCondition(-4020, ss);
+      return;
+    }
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Export3dSolidMesh::writeInterfaceMeshFile(TriangleGeom* triangleGeom, const std::vector<size_t>& faceOffsets, const std::vector<size_t>& faceList, const QString& file)
+{
+  notifyStatusMessage("Writing grain boundary mesh file");
+
+  const float* vertices = triangleGeom->getVertexPointer(0);
+  const MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+  size_t numInterfaces = faceOffsets.size() - 1;
+  std::vector<size_t> vertexOffsets;
+  std::vector<size_t> vertexList;
+  AssignVerticesToInterfaces(triangles, triangleGeom->getNumberOfVertices(), faceOffsets, faceList, vertexOffsets, vertexList);
+
+  FILE* f = fopen(file.toLocal8Bit().data(), "wb");
+  if(nullptr == f)
+  {
+    QString ss = QObject::tr("Error creating grain boundary mesh file '%1'").arg(file);
+    setErrorCondition(-4023, ss);
+    return;
+  }
+
+  // Binary MSH 4.1: counts are size_t, tags and types int, coordinates double. The tag of a node is its vertex
+  // index + 1; element tags are the positions in faceList + 1.
+  auto writeSize = [f](size_t value) { fwrite(&value, sizeof(value), 1, f); };
+  auto writeInt = [f](int value) { fwrite(&value, sizeof(value), 1, f); };
+  auto writeDouble = [f](double value) { fwrite(&value, sizeof(value), 1, f); };
+
+  fprintf(f, "$MeshFormat\n4.1 1 %zu\n", sizeof(size_t));
+  writeInt(1);
+  fprintf(f, "\n$EndMeshFormat\n$Entities\n");
+  writeSize(0);
+  writeSize(0);
+  writeSize(numInterfaces);
+  writeSize(0);
+  for(size_t k = 0; k < numInterfaces; k++)
+  {
+    double minCoords[3] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+    double maxCoords[3] = {std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest(), std::numeric_limits<double>::lowest()};
+    for(size_t t = faceOffsets[k]; t < faceOffsets[k + 1]; t++)
+    {
+      const MeshIndexType* tri = triangles + 3 * faceList[t];
+      for(size_t c = 0; c < 3; c++)
+      {
+        for(size_t d = 0; d < 3; d++)
+        {
+          minCoords[d] = std::min(minCoords[d], static_cast<double>(vertices[3 * tri[c] + d]));
+          maxCoords[d] = std::max(maxCoords[d], static_cast<double>(vertices[3 * tri[c] + d]));
+        }
+      }
+    }
+    writeInt(static_cast<int>(k + 1));
+    for(double value : minCoords)
+    {
+      writeDouble(value);
+    }
+    for(double value : maxCoords)
+    {
+      writeDouble(value);
+    }
+    writeSize(0); // physical tags
+    writeSize(0); // bounding curves
+  }
+
+  fprintf(f, "\n$EndEntities\n$Nodes\n");
+  writeSize(numInterfaces);
+  writeSize(vertexList.size());
+  writeSize(vertexList.empty() ? 0 : *std::min_element(vertexList.begin(), vertexList.end()) + 1);
+  writeSize(vertexList.empty() ? 0 : *std::max_element(vertexList.begin(), vertexList.end()) + 1);
+  for(size_t k = 0; k < numInterfaces; k++)
+  {
+    writeInt(2);
+    writeInt(static_cast<int>(k + 1));
+    writeInt(0);
+    writeSize(vertexOffsets[k + 1] - vertexOffsets[k]);
+    for(size_t v = vertexOffsets[k]; v < vertexOffsets[k + 1]; v++)
+    {
+      writeSize(vertexList[v] + 1);
+    }
+    for(size_t v = vertexOffsets[k]; v < vertexOffsets[k + 1]; v++)
+    {
+      const float* coords = vertices + 3 * vertexList[v];
+      writeDouble(coords[0]);
+      writeDouble(coords[1]);
+      writeDouble(coords[2]);
+    }
+  }
+
+  // 2 is Gmsh's element type of a linear triangle
+  fprintf(f, "\n$EndNodes\n$Elements\n");
+  writeSize(numInterfaces);
+  writeSize(faceList.size());
+  writeSize(faceList.empty() ? 0 : 1);
+  writeSize(faceList.size());
+  for(size_t k = 0; k < numInterfaces; k++)
+  {
+    writeInt(2);
+    writeInt(static_cast<int>(k + 1));
+    writeInt(2);
+    writeSize(faceOffsets[k + 1] - faceOffsets[k]);
+    for(size_t t = faceOffsets[k]; t < faceOffsets[k + 1]; t++)
+    {
+      const MeshIndexType* tri = triangles + 3 * faceList[t];
+      writeSize(t + 1);
+      writeSize(tri[0] + 1);
+      writeSize(tri[1] + 1);
+      writeSize(tri[2] + 1);
+    }
   }
+  fprintf(f, "\n$EndElements\n");
 
-  fclose(f1);
+  bool failed = (ferror(f) != 0);
+  if(fclose(f) != 0 || failed)
+  {
+    QString ss = QObject::tr("Error writing grain boundary mesh file '%1'").arg(file);
+    setErrorCondition(-4023, ss);
+  }
 }
 
 // -----------------------------------------------------------------------------
@@ -599,29 +1704,15 @@ void Export3dSolidMesh::runPackage(const QString& file, const QString& meshFile)
   QString switches;
   QStringList arguments;
 
-  program = m_PackageLocation + QDir::separator();
-
   switch(m_MeshingPackage)
   {
   case 0: // TetGen
   {
     // cmd to run: "tetgen -pYAqOa file
 
-    switches = "-pYAO" + QString::number(m_OptimizationLevel);
-
-    if(m_RefineMesh)
-    {
-      QString tmp = "q" + QString::number(m_MaxRadiusEdgeRatio) + "/" + QString::number(m_MinDihedralAngle);
-      switches += tmp;
-    }
-
-    if(m_LimitTetrahedraVolume)
-    {
-      QString tmp = "a" + QString::number(m_MaxTetrahedraVolume);
-      switches += tmp;
-    }
+    switches = "-" + getTetGenSwitches();
 
-    program += "tetgen";
+    program = getPackageProgram("tetgen");
 
     arguments << switches << file;
 
@@ -632,36 +1723,9 @@ void Export3dSolidMesh::runPackage(const QString& file, const QString& meshFile)
 
     // cmd to run: "netgen file.stlb -batchmode -verycoarse/coarse/moderate/fine/veryfine -meshfile=output filename
 
-    switches = "-";
-    if(m_MeshSize == 0)
-    {
-      switches += "verycoarse";
-    }
-    else if(m_MeshSize == 1)
-    {
-      switches += "coarse";
-    }
-    else if(m_MeshSize == 2)
-    {
-      switches += "moderate";
-    }
-    else if(m_MeshSize == 3)
-    {
-      switches += "fine";
-    }
-    else if(m_MeshSize == 4)
-    {
-      switches += "veryfine";
-    }
-
-    program += "netgen";
-
-    QString switchMeshFile;
-
-    switchMeshFile = "-meshfile=";
-    switchMeshFile += meshFile;
+    program = getPackageProgram("netgen");
 
-    arguments << file << "-batchmode" << switchMeshFile << "-V" << switches;
+    arguments = getNetgenArguments(file, meshFile);
 
     break;
   }
@@ -679,338 +1743,909 @@ void Export3dSolidMesh::runPackage(const QString& file, const QString& meshFile)
     }
     else
     {
-      switch2 = "auto";
+      // Version 4.1 of the MSH format is what the filter reads back
+      switch2 = "msh41";
     }
 
     switches = "-3";
-    program += "gmsh";
+    program = getPackageProgram("gmsh");
     arguments << file << switches << switch1 << switch2;
 
     break;
   }
   }
 
-  m_ProcessPtr = QSharedPointer<QProcess>(new QProcess(nullptr));
-
-  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-
-#if defined(Q_OS_MAC)
-  if(m_MeshingPackage == 1)
+  SimulationIO::ExternalJobRunner::Job job;
+  job.program = program;
+  job.arguments = arguments;
+  job.workingDirectory = m_WorkingDirectory;
+  job.environment = (m_MeshingPackage == 1) ? getNetgenEnvironment() : QProcessEnvironment::systemEnvironment();
+
+  // The output of the package is passed on line by line as status messages
+  SimulationIO::ExternalJobRunner runner;
+  runner.setCancelCallback([this]() { return getCancel(); });
+  runner.setOutputCallback([this](int, const QString& line) { notifyStatusMessage(line); });
+  runner.addJob(job);
+  runner.run();
+
+  const SimulationIO::ExternalJobRunner::Result& result = runner.getResult(0);
+  if(result.status == SimulationIO::ExternalJobRunner::Status::Canceled)
   {
-    QString env_PYTHONPATH = m_PackageLocation + QDir::separator() + QString("..") + QDir::separator() + QString("Resources") + QDir::separator() + QString("lib") + QDir::separator() +
-                             QString("python3.7") + QDir::separator() + QString("site-packages");
-    QString env_NETGENDIR = m_PackageLocation;
-    QString env_DYLD_LIBRARYPATH = m_PackageLocation;
-
-    env.insert("PYTHONPATH", env_PYTHONPATH);
-    env.insert("NETGENDIR", env_NETGENDIR);
-    env.insert("DYLD_LIBRARY_PATH", env_DYLD_LIBRARYPATH);
-
-    //      env.insert("PYTHONPATH", "/Applications/Netgen.app/Contents/Resources/lib/python3.7/site-packages:.");
-    //  env.insert("NETGENDIR", "/Applications/Netgen.app/Contents/MacOS");
-    // env.insert("DYLD_LIBRARY_PATH", "/Applications/Netgen.app/Contents/MacOS");
-    // env.insert("PATH", "$NETGENDIR:$PATH");
+    setWarningCondition(-4004, runner.getErrorMessage(0));
+    return;
+  }
+  int errorCode = SimulationIO::ExternalJobRunner::ErrorCode(result);
+  if(errorCode < 0)
+  {
+    setErrorCondition(errorCode, runner.getErrorMessage(0));
+    return;
   }
-#endif
-  m_ProcessPtr->setProcessEnvironment(env);
-
-  qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
-  qRegisterMetaType<QProcess::ProcessError>("QProcess::ProcessError");
-  connect(m_ProcessPtr.data(), SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processHasFinished(int, QProcess::ExitStatus)), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(error(QProcess::ProcessError)), this, SLOT(processHasErroredOut(QProcess::ProcessError)), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(readyReadStandardError()), this, SLOT(sendErrorOutput()), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(readyReadStandardOutput()), this, SLOT(sendStandardOutput()), Qt::QueuedConnection);
 
-  m_ProcessPtr->setWorkingDirectory(m_outputPath);
-  m_ProcessPtr->start(program, arguments);
-  m_ProcessPtr->waitForStarted(2000);
-  m_ProcessPtr->waitForFinished(-1);
+  notifyStatusMessage(QObject::tr("Finished running Package in %1").arg(SimulationIO::ExternalJobRunner::FormatTimes(runner.getWallTime(), runner.getCpuTime())));
+}
 
-  notifyStatusMessage("Finished running Package");
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString Export3dSolidMesh::getPackageProgram(const QString& name) const
+{
+  // Resolved here, as a relative program path would otherwise be looked up in the working directory of the job
+  if(m_PackageLocation.isEmpty())
+  {
+    return name;
+  }
+  return QDir(m_PackageLocation).absoluteFilePath(name);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Export3dSolidMesh::mergeMesh(const QString& mergeFile, const QString& meshFile)
+QProcessEnvironment Export3dSolidMesh::getNetgenEnvironment() const
 {
+  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
 
-  QString program;
-  QStringList arguments;
-
-  QString switch1;
-  switch1 = "-inputmeshfile=";
-  switch1 += mergeFile;
-
-  QString switch2;
-  switch2 = "-mergefile=";
-  switch2 += meshFile;
-
-  QString switch3;
-  switch3 = "-meshfile=";
-  switch3 += mergeFile;
-
-  program = m_PackageLocation + QDir::separator() + "netgen";
-
-  // cmd to run: netgen -inputmeshfile=m.vol -mergefile=c.vol -batchmode -meshfile=m.vol
-
-  arguments << "-batchmode" << switch1 << switch2 << switch3 << "-V";
-
-  m_ProcessPtr = QSharedPointer<QProcess>(new QProcess(nullptr));
-
-  QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-
-#if defined(Q_OS_MAC)
-  QString env_PYTHONPATH = m_PackageLocation + QDir::separator() + QString("..") + QDir::separator() + QString("Resources") + QDir::separator() + QString("lib") + QDir::separator() +
-                           QString("python3.7") + QDir::separator() + QString("site-packages");
-  QString env_NETGENDIR = m_PackageLocation;
-  QString env_DYLD_LIBRARYPATH = m_PackageLocation;
+#if defined(Q_OS_MAC)
+  QString packageLocation = QDir(m_PackageLocation).absolutePath();
+  QString env_PYTHONPATH = packageLocation + QDir::separator() + QString("..") + QDir::separator() + QString("Resources") + QDir::separator() + QString("lib") + QDir::separator() +
+                           QString("python3.7") + QDir::separator() + QString("site-packages");
+  QString env_NETGENDIR = packageLocation;
+  QString env_DYLD_LIBRARYPATH = packageLocation;
 
   env.insert("PYTHONPATH", env_PYTHONPATH);
   env.insert("NETGENDIR", env_NETGENDIR);
   env.insert("DYLD_LIBRARY_PATH", env_DYLD_LIBRARYPATH);
-#endif
 
   // env.insert("PYTHONPATH", "/Applications/Netgen.app/Contents/Resources/lib/python3.7/site-packages:.");
   // env.insert("NETGENDIR", "/Applications/Netgen.app/Contents/MacOS");
   // env.insert("DYLD_LIBRARY_PATH", "/Applications/Netgen.app/Contents/MacOS");
   // env.insert("PATH", "$NETGENDIR:$PATH");
+#endif
 
-  m_ProcessPtr->setProcessEnvironment(env);
+  return env;
+}
 
-  qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
-  qRegisterMetaType<QProcess::ProcessError>("QProcess::ProcessError");
-  connect(m_ProcessPtr.data(), SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processHasFinished(int, QProcess::ExitStatus)), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(error(QProcess::ProcessError)), this, SLOT(processHasErroredOut(QProcess::ProcessError)), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(readyReadStandardError()), this, SLOT(sendErrorOutput()), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(readyReadStandardOutput()), this, SLOT(sendStandardOutput()), Qt::QueuedConnection);
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList Export3dSolidMesh::getNetgenArguments(const QString& file, const QString& meshFile) const
+{
+  // cmd to run: "netgen file.stlb -batchmode -verycoarse/coarse/moderate/fine/veryfine -meshfile=output filename
+  QString switches = "-";
+  if(m_MeshSize == 0)
+  {
+    switches += "verycoarse";
+  }
+  else if(m_MeshSize == 1)
+  {
+    switches += "coarse";
+  }
+  else if(m_MeshSize == 2)
+  {
+    switches += "moderate";
+  }
+  else if(m_MeshSize == 3)
+  {
+    switches += "fine";
+  }
+  else if(m_MeshSize == 4)
+  {
+    switches += "veryfine";
+  }
 
-  m_ProcessPtr->setWorkingDirectory(m_outputPath);
-  m_ProcessPtr->start(program, arguments);
-  m_ProcessPtr->waitForStarted(2000);
-  m_ProcessPtr->waitForFinished(-1);
+  QString switchMeshFile = "-meshfile=" + meshFile;
 
-  notifyStatusMessage("Merging individual volume meshes");
+  QStringList arguments;
+  arguments << file << "-batchmode" << switchMeshFile << "-V" << switches;
+  return arguments;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Export3dSolidMesh::processHasFinished(int exitCode, QProcess::ExitStatus exitStatus)
+void Export3dSolidMesh::runNetgenJobs(const QStringList& inputFiles, const QStringList& meshFiles)
 {
-  if(getCancel())
+  int numJobs = inputFiles.size();
+  QString program = getPackageProgram("netgen");
+  QProcessEnvironment env = getNetgenEnvironment();
+
+  SimulationIO::ExternalJobRunner runner;
+  runner.setMaxConcurrentJobs(m_MaxNetgenProcesses);
+  runner.setCancelCallback([this]() { return getCancel(); });
+  for(int i = 0; i < numJobs; i++)
   {
+    // Every process gets its own working directory, so the files Netgen writes next to itself do not collide
+    QFileInfo meshFileInfo(meshFiles[i]);
+    SimulationIO::ExternalJobRunner::Job job;
+    job.program = program;
+    job.arguments = getNetgenArguments(inputFiles[i], meshFiles[i]);
+    job.workingDirectory = meshFileInfo.absolutePath() + QDir::separator() + meshFileInfo.completeBaseName() + "_netgen";
+    job.environment = env;
+    job.logFile = job.workingDirectory + QDir::separator() + "netgen.log";
+    runner.addJob(job);
+    QFile::remove(meshFiles[i]);
   }
-  else if(exitStatus == QProcess::CrashExit)
+
+  int finishedJobs = 0;
+  runner.setFinishedCallback([&](int index, const SimulationIO::ExternalJobRunner::Result& result) {
+    int feature = index + 1;
+    const SimulationIO::ExternalJobRunner::Job& job = runner.getJob(index);
+    if(result.status == SimulationIO::ExternalJobRunner::Status::FailedToStart)
+    {
+      QString ss = QObject::tr("Netgen failed to start for feature %1. Either the package is missing, or you may have insufficient permissions. Executable: %2").arg(feature).arg(program);
+      setErrorCondition(-4005, ss);
+    }
+    else if(result.status == SimulationIO::ExternalJobRunner::Status::Crashed)
+    {
+      QString ss = QObject::tr("Netgen crashed while meshing feature %1. See %2").arg(feature).arg(job.logFile);
+      setErrorCondition(-4006, ss);
+    }
+    else if(result.exitCode != 0)
+    {
+      QString ss = QObject::tr("Netgen finished with exit code %1 while meshing feature %2. See %3").arg(result.exitCode).arg(feature).arg(job.logFile);
+      setErrorCondition(-4004, ss);
+    }
+    else if(!QFileInfo::exists(meshFiles[index]))
+    {
+      QString ss = QObject::tr("Netgen did not create the mesh file '%1' for feature %2. See %3").arg(meshFiles[index]).arg(feature).arg(job.logFile);
+      setErrorCondition(-4015, ss);
+    }
+    else
+    {
+      // Keep the log of failed jobs only
+      QDir(job.workingDirectory).removeRecursively();
+    }
+
+    finishedJobs++;
+    notifyStatusMessage(QObject::tr("Meshed %1 of %2 features with Netgen").arg(finishedJobs).arg(numJobs));
+    // Stop meshing at the first failure
+    return getErrorCode() >= 0;
+  });
+
+  notifyStatusMessage(QObject::tr("Meshing %1 features with up to %2 Netgen processes").arg(numJobs).arg(runner.getMaxConcurrentJobs()));
+  if(runner.run())
   {
-    QString ss = QObject::tr("The process crashed during its exit.");
-    setErrorCondition(-4003, ss);
+    notifyStatusMessage(QObject::tr("Meshed %1 features with Netgen in %2").arg(numJobs).arg(SimulationIO::ExternalJobRunner::FormatTimes(runner.getWallTime(), runner.getCpuTime())));
   }
-  else if(exitCode < 0)
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Export3dSolidMesh::scanTetGenFile(const QString& fileEle, const QString& fileNode, DataContainer* dataContainer, AttributeMatrix* vertexAttrMat, AttributeMatrix* cellAttrMat)
+{
+  // TetGen has no binary .node/.ele output, so the text files are memory mapped and parsed in parallel
+  // chunks. Every record is stored at the position given by its own index, which makes the chunks independent.
+  QFile inStreamNode(fileNode);
+  QFile inStreamEle(fileEle);
+
+  if(!inStreamEle.open(QIODevice::ReadOnly))
   {
-    QString ss = QObject::tr("The process finished with exit code %1.").arg(QString::number(exitCode));
-    setErrorCondition(-4004, ss);
+    QString ss = QObject::tr("Input file could not be opened: %1").arg(fileEle);
+    setErrorCondition(-100, ss);
+    return;
   }
-  else if(getErrorCode() >= 0)
+
+  if(!inStreamNode.open(QIODevice::ReadOnly))
   {
+    QString ss = QObject::tr("Input file could not be opened: %1").arg(fileNode);
+    setErrorCondition(-100, ss);
+    return;
   }
 
-  m_Pause = false;
-  m_WaitCondition.wakeAll();
+  QByteArray nodeBuffer;
+  QByteArray eleBuffer;
+  size_t nodeSize = 0;
+  size_t eleSize = 0;
+  const char* nodeBegin = MapTextFile(inStreamNode, nodeBuffer, nodeSize);
+  const char* nodeEnd = nodeBegin + nodeSize;
+  const char* eleBegin = MapTextFile(inStreamEle, eleBuffer, eleSize);
+  const char* eleEnd = eleBegin + eleSize;
+
+  // .node header: <# of points> <dimension> <# of attributes> <boundary markers>
+  // .ele header: <# of tetrahedra> <nodes per tetrahedron> <# of attributes>
+  int64_t nodeHeader[4] = {0, 0, 0, 0};
+  int64_t eleHeader[3] = {0, 0, 0};
+  const char* nodeBody = ReadTetGenHeader(nodeBegin, nodeEnd, nodeHeader, 4);
+  const char* eleBody = ReadTetGenHeader(eleBegin, eleEnd, eleHeader, 3);
+  if(nullptr == nodeBody || nodeHeader[0] < 0 || nodeHeader[1] != 3)
+  {
+    QString ss = QObject::tr("Invalid header in TetGen node file: %1").arg(fileNode);
+    setErrorCondition(-101, ss);
+    return;
+  }
+  if(nullptr == eleBody || eleHeader[0] < 0 || eleHeader[1] < 4 || eleHeader[2] < 0)
+  {
+    QString ss = QObject::tr("Invalid header in TetGen element file: %1").arg(fileEle);
+    setErrorCondition(-101, ss);
+    return;
+  }
+
+  size_t numVerts = static_cast<size_t>(nodeHeader[0]);
+  size_t numCells = static_cast<size_t>(eleHeader[0]);
+
+  // The records are parsed straight into the arrays, so with OutOfCoreMesh nothing of the mesh is held in RAM
+  Int32ArrayType::Pointer featureIDsdata = allocateVolumeMesh(dataContainer, vertexAttrMat, cellAttrMat, numVerts, numCells);
+  if(nullptr == featureIDsdata.get())
+  {
+    return;
+  }
+  TetrahedralGeom::Pointer tetGeomPtr = dataContainer->getGeometryAs<TetrahedralGeom>();
+  float* tetvertex = tetGeomPtr->getVertexPointer(0);
+  MeshIndexType* tets = tetGeomPtr->getTetPointer(0);
+
+  // Indices start at 0 or 1 depending on the input; the first record tells which
+  int64_t firstNumber = 1;
+  const char* p = nodeBody;
+  while(p < nodeEnd && SimulationIO::TextParsing::IsEndOfLine(p, nodeEnd))
+  {
+    p = SimulationIO::TextParsing::NextLine(p, nodeEnd);
+  }
+  if(p < nodeEnd && !SimulationIO::TextParsing::ParseInt(p, nodeEnd, firstNumber))
+  {
+    firstNumber = 1;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  size_t numChunks = 4 * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+#else
+  size_t numChunks = 1;
+#endif
+
+  notifyStatusMessage("Reading TetGen nodes");
+  std::vector<size_t> nodeChunks = SimulationIO::TextParsing::SplitLines(nodeBody, nodeEnd, numChunks);
+  std::vector<size_t> nodeCounts(numChunks, 0);
+  std::vector<char> nodeErrors(numChunks, 0);
+  ParseTetGenNodesImpl nodesImpl(nodeBody, nodeChunks.data(), firstNumber, numVerts, tetvertex, nodeCounts.data(), nodeErrors.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), nodesImpl, tbb::simple_partitioner());
+#else
+  nodesImpl.convert(0, numChunks);
+#endif
+
+  if(std::find(nodeErrors.begin(), nodeErrors.end(), 1) != nodeErrors.end() || std::accumulate(nodeCounts.begin(), nodeCounts.end(), size_t(0)) != numVerts)
+  {
+    QString ss = QObject::tr("The TetGen node file is malformed or does not contain %1 nodes: %2").arg(numVerts).arg(fileNode);
+    setErrorCondition(-102, ss);
+    return;
+  }
+
+  notifyStatusMessage("Reading TetGen elements");
+  std::vector<size_t> eleChunks = SimulationIO::TextParsing::SplitLines(eleBody, eleEnd, numChunks);
+  std::vector<size_t> eleCounts(numChunks, 0);
+  std::vector<char> eleErrors(numChunks, 0);
+  ParseTetGenElementsImpl elementsImpl(eleBody, eleChunks.data(), firstNumber, numCells, static_cast<size_t>(eleHeader[1]), static_cast<size_t>(eleHeader[2]), numVerts, tets,
+                                       featureIDsdata->getPointer(0), eleCounts.data(), eleErrors.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numChunks, 1), elementsImpl, tbb::simple_partitioner());
+#else
+  elementsImpl.convert(0, numChunks);
+#endif
+
+  if(std::find(eleErrors.begin(), eleErrors.end(), 1) != eleErrors.end() || std::accumulate(eleCounts.begin(), eleCounts.end(), size_t(0)) != numCells)
+  {
+    QString ss = QObject::tr("The TetGen element file is malformed or does not contain %1 tetrahedra: %2").arg(numCells).arg(fileEle);
+    setErrorCondition(-102, ss);
+    return;
+  }
+
+  createCellData(cellAttrMat, featureIDsdata);
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Export3dSolidMesh::processHasErroredOut(QProcess::ProcessError error)
+void Export3dSolidMesh::scanVolumeMesh(const QString& file, DataContainer* dataContainer, AttributeMatrix* vertexAttrMat, AttributeMatrix* cellAttrMat)
 {
-  if(getCancel())
+  notifyStatusMessage("Reading volume mesh");
+  SimulationIO::VolumeMeshReader reader;
+  if(!reader.open(file))
   {
-    QString ss = QObject::tr("The process was killed by the user.");
-    setWarningCondition(-4004, ss);
+    setErrorCondition(-4018, reader.getErrorMessage());
+    return;
   }
-  else if(error == QProcess::FailedToStart)
+
+  size_t numVerts = reader.getNumberOfVertices();
+  size_t numCells = reader.getNumberOfTetrahedra();
+
+  Int32ArrayType::Pointer featureIDsdata = allocateVolumeMesh(dataContainer, vertexAttrMat, cellAttrMat, numVerts, numCells);
+  if(nullptr == featureIDsdata.get())
   {
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    QString pathEnv = env.value("PATH");
+    return;
+  }
+  TetrahedralGeom::Pointer tetGeomPtr = dataContainer->getGeometryAs<TetrahedralGeom>();
 
-    QString ss = QObject::tr("The package failed to start. Either the package is missing, or you may have insufficient permissions \
-or the path containing the executble is not in the system's environment path. PATH=%1.\n Try using the absolute path to the executable.")
-                     .arg(pathEnv);
-    setErrorCondition(-4005, ss);
+  // The region of a tetrahedron (Netgen material, Gmsh volume) is the id of its feature
+  if(!reader.read(tetGeomPtr->getVertexPointer(0), tetGeomPtr->getTetPointer(0), featureIDsdata->getPointer(0)))
+  {
+    setErrorCondition(-4018, reader.getErrorMessage());
+    return;
   }
-  else if(error == QProcess::Crashed)
+
+  if(reader.getNumberOfSkippedElements() > 0)
   {
-    QString ss = QObject::tr("The process crashed some time after starting successfully.");
-    setErrorCondition(-4006, ss);
+    QString ss = QObject::tr("%1 volume elements of %2 are not tetrahedra and were not read").arg(reader.getNumberOfSkippedElements()).arg(file);
+    setWarningCondition(-4019, ss);
   }
-  else if(error == QProcess::Timedout)
+
+  createCellData(cellAttrMat, featureIDsdata);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+template <typename T>
+typename DataArray<T>::Pointer Export3dSolidMesh::createMeshArray(size_t numTuples, const std::vector<size_t>& cDims, const QString& name)
+{
+  if(nullptr == m_ScratchStorage.get() || numTuples == 0)
   {
-    QString ss = QObject::tr("The process timed out.");
-    setErrorCondition(-4007, ss);
+    return DataArray<T>::CreateArray(numTuples, cDims, name, true);
   }
-  else if(error == QProcess::WriteError)
+
+  typename DataArray<T>::Pointer array = m_ScratchStorage->createArray<T>(numTuples, cDims, name);
+  if(nullptr == array.get())
   {
-    QString ss = QObject::tr("An error occurred when attempting to write to the process.");
-    setErrorCondition(-4008, ss);
+    setErrorCondition(-4025, m_ScratchStorage->getErrorMessage());
   }
-  else if(error == QProcess::ReadError)
+  return array;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+Int32ArrayType::Pointer Export3dSolidMesh::allocateVolumeMesh(DataContainer* dataContainer, AttributeMatrix* vertexAttrMat, AttributeMatrix* cellAttrMat, size_t numVerts,
+                                                              size_t numCells)
+{
+  std::vector<size_t> tDims(1, numCells);
+  cellAttrMat->resizeAttributeArrays(tDims);
+  tDims[0] = numVerts;
+  vertexAttrMat->resizeAttributeArrays(tDims);
+
+  std::vector<size_t> cDims(1, 4);
+  SharedTetList::Pointer tetList = createMeshArray<MeshIndexType>(numCells, cDims, SIMPL::Geometry::SharedTetList);
+  cDims[0] = 3;
+  SharedVertexList::Pointer vertexList = createMeshArray<float>(numVerts, cDims, SIMPL::Geometry::SharedVertexList);
+  cDims[0] = 1;
+  Int32ArrayType::Pointer featureIds = createMeshArray<int32_t>(numCells, cDims, "FeatureIDs");
+  if(nullptr == tetList.get() || nullptr == vertexList.get() || nullptr == featureIds.get())
   {
-    QString ss = QObject::tr("An error occurred when attempting to read from the process.");
-    setErrorCondition(-4009, ss);
+    return Int32ArrayType::NullPointer();
   }
-  else
+
+  TetrahedralGeom::Pointer tetGeomPtr = dataContainer->getGeometryAs<TetrahedralGeom>();
+  tetGeomPtr->setTets(tetList);
+  tetGeomPtr->setVertices(vertexList);
+
+  if(nullptr != m_ScratchStorage.get())
   {
-    QString ss = QObject::tr("An unknown error occurred.");
-    setErrorCondition(-4010, ss);
+    QString ss = QObject::tr("Volume mesh kept in %1 MB of scratch files in '%2'").arg(m_ScratchStorage->getNumberOfBytes() / (1024 * 1024)).arg(m_WorkingDirectory);
+    notifyStatusMessage(ss);
   }
 
-  m_Pause = false;
-  m_WaitCondition.wakeAll();
+  return featureIds;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Export3dSolidMesh::sendErrorOutput()
+void Export3dSolidMesh::createCellData(AttributeMatrix* cellAttrMat, const Int32ArrayType::Pointer& featureIds)
 {
-  if(m_ProcessPtr.data() != nullptr)
+  size_t numCells = featureIds->getNumberOfTuples();
+  cellAttrMat->insertOrAssign(featureIds);
+
+  std::vector<size_t> cDims(1, 3);
+  FloatArrayType::Pointer eulerangles = createMeshArray<float>(numCells, cDims, "Euler Angles");
+  cDims[0] = 1;
+  Int32ArrayType::Pointer phasesdata = createMeshArray<int32_t>(numCells, cDims, "Phases");
+  if(nullptr == eulerangles.get() || nullptr == phasesdata.get())
   {
-    QString error = m_ProcessPtr->readAllStandardError();
-    if(error[error.size() - 1] == '\n')
-    {
-      error.chop(1);
-    }
-    notifyStatusMessage(error);
-    m_WaitCondition.wakeAll();
+    return;
+  }
+  cellAttrMat->insertOrAssign(eulerangles);
+  cellAttrMat->insertOrAssign(phasesdata);
+
+  // One gather over all cells once the feature ids are known
+  std::atomic<bool> invalidIds(false);
+  CopyFeatureDataImpl impl(featureIds->getPointer(0), m_FeaturePhases, m_FeatureEulerAngles, m_FeaturePhasesPtr.lock()->getNumberOfTuples(), phasesdata->getPointer(0),
+                           eulerangles->getPointer(0), &invalidIds);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numCells), impl, tbb::auto_partitioner());
+#else
+  impl.convert(0, numCells);
+#endif
+
+  if(invalidIds)
+  {
+    QString ss = QObject::tr("Some tetrahedra have a feature id that is not a valid feature; their Phases and Euler Angles were set to 0");
+    setWarningCondition(-4014, ss);
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString Export3dSolidMesh::getTetGenSwitches() const
+{
+  QString switches = "pYAO" + QString::number(m_OptimizationLevel);
+
+  if(m_RefineMesh)
+  {
+    switches += "q" + QString::number(m_MaxRadiusEdgeRatio) + "/" + QString::number(m_MinDihedralAngle);
+  }
+
+  // A bare 'a' applies the maximum volumes of the region list
+  if(m_UseFeatureSizeField)
+  {
+    switches += "a";
   }
+
+  if(m_LimitTetrahedraVolume)
+  {
+    switches += "a" + QString::number(m_MaxTetrahedraVolume);
+  }
+
+  return switches;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Export3dSolidMesh::sendStandardOutput()
+std::vector<double> Export3dSolidMesh::getFeatureMaxVolumes(size_t numfeatures) const
 {
-  if(m_ProcessPtr.data() != nullptr)
+  std::vector<double> maxVolumes(numfeatures, -1.0);
+  for(size_t i = 1; i < numfeatures; i++)
   {
-    notifyStatusMessage(m_ProcessPtr->readAllStandardOutput());
-    m_WaitCondition.wakeAll();
+    if(m_FeatureVolumes[i] > 0.0f)
+    {
+      maxVolumes[i] = static_cast<double>(m_FeatureVolumes[i]) / m_TetrahedraPerFeature;
+    }
   }
+  return maxVolumes;
 }
 
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
-void Export3dSolidMesh::scanTetGenFile(const QString& fileEle, const QString& fileNode, DataContainer* dataContainer, AttributeMatrix* vertexAttrMat, AttributeMatrix* cellAttrMat)
+void Export3dSolidMesh::runTetGenLibrary(TriangleGeom* triangleGeom, size_t numfeatures, float* centroid, DataContainer* dataContainer, AttributeMatrix* vertexAttrMat,
+                                         AttributeMatrix* cellAttrMat)
 {
+#ifdef SimulationIO_USE_TETGEN_LIBRARY
+  MeshIndexType numNodes = triangleGeom->getNumberOfVertices();
+  MeshIndexType numTri = triangleGeom->getNumberOfTris();
+  float* nodes = triangleGeom->getVertexPointer(0);
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+
+  // TetGen indexes everything with int
+  if(numNodes > static_cast<MeshIndexType>(INT_MAX) || numTri > static_cast<MeshIndexType>(INT_MAX))
+  {
+    QString ss = QObject::tr("The surface mesh has too many vertices or triangles for TetGen (%1 vertices, %2 triangles)").arg(numNodes).arg(numTri);
+    setErrorCondition(-4013, ss);
+    return;
+  }
 
-  bool allocate = true;
-  bool ok = false;
-  QFile inStreamNode(fileNode);
-  QFile inStreamEle(fileEle);
+  notifyStatusMessage("Running TetGen");
 
-  if(!inStreamEle.open(QIODevice::ReadOnly | QIODevice::Text))
+  // The input lists live in these vectors rather than being allocated per facet with new[]; they are
+  // detached from the tetgenio again before it is destroyed
+  std::vector<REAL> points(nodes, nodes + 3 * numNodes);
+  std::vector<int> vertexList(3 * numTri);
+  std::vector<tetgenio::polygon> polygons(numTri);
+  std::vector<tetgenio::facet> facets(numTri);
+  for(MeshIndexType k = 0; k < numTri; k++)
   {
-    QString ss = QObject::tr("Input file could not be opened: %1").arg(fileEle);
-    setErrorCondition(-100, ss);
-    return;
+    vertexList[3 * k] = static_cast<int>(triangles[3 * k]);
+    vertexList[3 * k + 1] = static_cast<int>(triangles[3 * k + 1]);
+    vertexList[3 * k + 2] = static_cast<int>(triangles[3 * k + 2]);
+    polygons[k].vertexlist = vertexList.data() + 3 * k;
+    polygons[k].numberofvertices = 3;
+    facets[k].polygonlist = polygons.data() + k;
+    facets[k].numberofpolygons = 1;
+    facets[k].holelist = nullptr;
+    facets[k].numberofholes = 0;
   }
 
-  if(!inStreamNode.open(QIODevice::ReadOnly | QIODevice::Text))
+  // One region per feature, seeded at the feature centroid: x y z attribute maximum-volume
+  std::vector<double> maxVolumes = m_UseFeatureSizeField ? getFeatureMaxVolumes(numfeatures) : std::vector<double>();
+  size_t numRegions = numfeatures > 0 ? numfeatures - 1 : 0;
+  std::vector<REAL> regions(5 * numRegions);
+  for(size_t i = 1; i < numfeatures; i++)
   {
-    QString ss = QObject::tr("Input file could not be opened: %1").arg(fileNode);
-    setErrorCondition(-100, ss);
-    return;
+    REAL* region = regions.data() + 5 * (i - 1);
+    region[0] = centroid[i * 3];
+    region[1] = centroid[i * 3 + 1];
+    region[2] = centroid[i * 3 + 2];
+    region[3] = static_cast<REAL>(i);
+    region[4] = maxVolumes.empty() ? -1.0 : maxVolumes[i];
   }
 
-  QByteArray bufNode;
-  QByteArray bufEle;
-  QList<QByteArray> tokensNode;
-  QList<QByteArray> tokensEle;
+  tetgenio in;
+  tetgenio out;
+  in.firstnumber = 0;
+  in.numberofpoints = static_cast<int>(numNodes);
+  in.pointlist = points.data();
+  in.numberoffacets = static_cast<int>(numTri);
+  in.facetlist = facets.data();
+  in.numberofregions = static_cast<int>(numRegions);
+  in.regionlist = regions.data();
+
+  QByteArray switches = ("Q" + getTetGenSwitches()).toLatin1();
+  tetgenbehavior behavior;
+  bool parsed = behavior.parse_commandline(switches.data());
+
+  int tetgenError = 0;
+  if(parsed)
+  {
+    try
+    {
+      tetrahedralize(&behavior, &in, &out);
+    } catch(int code)
+    {
+      tetgenError = code;
+    }
+  }
 
-  bufEle = inStreamEle.readLine();
-  bufEle = bufEle.trimmed();
-  bufEle = bufEle.simplified();
-  tokensEle = bufEle.split(' ');
-  size_t numCells = tokensEle.at(0).toULongLong(&ok);
-  std::vector<size_t> tDims(1, numCells);
-  cellAttrMat->resizeAttributeArrays(tDims);
+  in.pointlist = nullptr;
+  in.numberofpoints = 0;
+  in.facetlist = nullptr;
+  in.numberoffacets = 0;
+  in.regionlist = nullptr;
+  in.numberofregions = 0;
 
-  bufNode = inStreamNode.readLine();
-  bufNode = bufNode.trimmed();
-  bufNode = bufNode.simplified();
-  tokensNode = bufNode.split(' ');
-  size_t numVerts = tokensNode.at(0).toULongLong(&ok);
-  tDims[0] = numVerts;
-  vertexAttrMat->resizeAttributeArrays(tDims);
+  if(!parsed)
+  {
+    QString ss = QObject::tr("TetGen rejected the switches '%1'").arg(QString::fromLatin1(switches));
+    setErrorCondition(-4012, ss);
+    return;
+  }
+  if(tetgenError != 0 || nullptr == out.pointlist || nullptr == out.tetrahedronlist || nullptr == out.tetrahedronattributelist)
+  {
+    QString ss = QObject::tr("TetGen failed to mesh the surface mesh (error %1)").arg(tetgenError);
+    setErrorCondition(-4012, ss);
+    return;
+  }
+
+  size_t numVerts = static_cast<size_t>(out.numberofpoints);
+  size_t numCells = static_cast<size_t>(out.numberoftetrahedra);
+  size_t numCorners = static_cast<size_t>(out.numberofcorners);
+  size_t numAttributes = static_cast<size_t>(out.numberoftetrahedronattributes);
 
+  Int32ArrayType::Pointer featureIDsdata = allocateVolumeMesh(dataContainer, vertexAttrMat, cellAttrMat, numVerts, numCells);
+  if(nullptr == featureIDsdata.get())
+  {
+    return;
+  }
   TetrahedralGeom::Pointer tetGeomPtr = dataContainer->getGeometryAs<TetrahedralGeom>();
-  tetGeomPtr->resizeTetList(numCells);
-  tetGeomPtr->resizeVertexList(numVerts);
 
-  //  SharedVertexList::Pointer tetvertexPtr = TetrahedralGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts), allocate);
   float* tetvertex = tetGeomPtr->getVertexPointer(0);
-  for(size_t i = 0; i < numVerts; i++)
+  for(size_t i = 0; i < 3 * numVerts; i++)
   {
-    bufNode = inStreamNode.readLine();
-    bufNode = bufNode.trimmed();
-    bufNode = bufNode.simplified();
-    tokensNode = bufNode.split(' ');
-    tetvertex[3 * i] = tokensNode[1].toFloat(&ok);
-    tetvertex[3 * i + 1] = tokensNode[2].toFloat(&ok);
-    tetvertex[3 * i + 2] = tokensNode[3].toFloat(&ok);
+    tetvertex[i] = static_cast<float>(out.pointlist[i]);
   }
 
-  //  SharedVertexList::Pointer tetvertexPtr = TetrahedralGeom::CreateSharedVertexList(static_cast<int64_t>(numVerts), allocate);
-  // TetrahedralGeom::Pointer tetGeomPtr = TetrahedralGeom::CreateGeometry(static_cast<int64_t>(numCells), tetvertexPtr, SIMPL::Geometry::TetrahedralGeometry, allocate);
-  //  tetGeomPtr->setSpatialDimensionality(3);
-
+  int32_t* featureIdPtr = featureIDsdata->getPointer(0);
   MeshIndexType* tets = tetGeomPtr->getTetPointer(0);
+  for(size_t i = 0; i < numCells; i++)
+  {
+    for(size_t j = 0; j < 4; j++)
+    {
+      tets[4 * i + j] = static_cast<MeshIndexType>(out.tetrahedronlist[numCorners * i + j]);
+    }
+    featureIdPtr[i] = static_cast<int32_t>(out.tetrahedronattributelist[numAttributes * i]);
+  }
 
-  QString dataArrayName = "FeatureIDs";
-  Int32ArrayType::Pointer featureIDsdata = Int32ArrayType::NullPointer();
-  int32_t numComp = 1;
-  std::vector<size_t> cDims(1, static_cast<size_t>(numComp));
-  featureIDsdata = Int32ArrayType::CreateArray(numCells, cDims, dataArrayName, allocate);
-  cellAttrMat->insertOrAssign(featureIDsdata);
-
-  dataArrayName = "Euler Angles";
-  FloatArrayType::Pointer eulerangles = FloatArrayType::NullPointer();
-  numComp = 3;
-  cDims[0] = static_cast<size_t>(numComp);
-  eulerangles = FloatArrayType::CreateArray(numCells, cDims, dataArrayName, allocate);
-  cellAttrMat->insertOrAssign(eulerangles);
+  createCellData(cellAttrMat, featureIDsdata);
 
-  dataArrayName = "Phases";
-  Int32ArrayType::Pointer phasesdata = Int32ArrayType::NullPointer();
-  numComp = 1;
-  cDims[0] = static_cast<size_t>(numComp);
-  phasesdata = Int32ArrayType::CreateArray(numCells, cDims, dataArrayName, allocate);
-  cellAttrMat->insertOrAssign(phasesdata);
+  notifyStatusMessage("Finished running TetGen");
+#else
+  Q_UNUSED(triangleGeom)
+  Q_UNUSED(numfeatures)
+  Q_UNUSED(centroid)
+  Q_UNUSED(dataContainer)
+  Q_UNUSED(vertexAttrMat)
+  Q_UNUSED(cellAttrMat)
+#endif
+}
 
-  for(size_t i = 0; i < numCells; i++)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int Export3dSolidMesh::getGmshThreadCount() const
+{
+  return (m_GmshNumThreads > 0) ? m_GmshNumThreads : QThread::idealThreadCount();
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void Export3dSolidMesh::runGmshLibrary(TriangleGeom* triangleGeom, size_t numfeatures, DataContainer* dataContainer, AttributeMatrix* vertexAttrMat, AttributeMatrix* cellAttrMat)
+{
+#ifdef SimulationIO_USE_GMSH_LIBRARY
+  MeshIndexType numNodes = triangleGeom->getNumberOfVertices();
+  float* nodes = triangleGeom->getVertexPointer(0);
+  MeshIndexType* triangles = triangleGeom->getTriPointer(0);
+
+  std::vector<size_t> faceOffsets;
+  std::vector<size_t> faceList;
+  std::vector<std::vector<int>> surfaceLoops;
+  if(m_ConformalMesh)
+  {
+    std::vector<std::pair<size_t, size_t>> interfaces;
+    BucketFacesByInterface(m_SurfaceMeshFaceLabels, triangleGeom->getNumberOfTris(), numfeatures, interfaces, faceOffsets, faceList);
+    surfaceLoops = GetInterfaceSurfaceLoops(interfaces, numfeatures);
+  }
+  else
+  {
+    BucketFacesByFeature(m_SurfaceMeshFaceLabels, triangleGeom->getNumberOfTris(), numfeatures, faceOffsets, faceList);
+  }
+
+  notifyStatusMessage("Running Gmsh");
+
+  std::vector<std::size_t> nodeTags;
+  std::vector<double> coords;
+  std::vector<std::vector<std::size_t>> tetNodeTags(numfeatures);
+  std::vector<char> hasVolume(numfeatures, 0);
+  std::size_t maxNodeTag = 0;
+  QString gmshError;
+  bool initialized = false;
+  // The Gmsh API works on one model and one set of options for the whole process, so in-process runs of all
+  // instances of the filter go one at a time, from gmsh::initialize() to gmsh::finalize()
+  static QMutex gmshMutex;
+  QMutexLocker gmshLock(&gmshMutex);
+  try
+  {
+    gmsh::initialize(0, nullptr, false);
+    initialized = true;
+    gmsh::option::setNumber("General.Terminal", 0);
+    gmsh::option::setNumber("General.NumThreads", getGmshThreadCount());
+    gmsh::option::setNumber("Mesh.Algorithm3D", k_GmshAlgorithms3D[m_GmshAlgorithm3D]);
+    gmsh::model::add("Export3dSolidMesh");
+
+    if(m_ConformalMesh)
+    {
+      // Same model as the conformal .geo file: every grain boundary is one discrete surface and node tag v + 1 is
+      // vertex v, added to the first surface that uses it. All nodes have to exist before the triangles refer to them.
+      std::vector<size_t> vertexOffsets;
+      std::vector<size_t> vertexList;
+      AssignVerticesToInterfaces(triangles, numNodes, faceOffsets, faceList, vertexOffsets, vertexList);
+      size_t numInterfaces = faceOffsets.size() - 1;
+      for(size_t k = 0; k < numInterfaces; k++)
+      {
+        std::vector<std::size_t> surfaceNodeTags;
+        std::vector<double> surfaceCoords;
+        for(size_t v = vertexOffsets[k]; v < vertexOffsets[k + 1]; v++)
+        {
+          surfaceNodeTags.push_back(vertexList[v] + 1);
+          surfaceCoords.push_back(nodes[3 * vertexList[v]]);
+          surfaceCoords.push_back(nodes[3 * vertexList[v] + 1]);
+          surfaceCoords.push_back(nodes[3 * vertexList[v] + 2]);
+        }
+        int tag = static_cast<int>(k + 1);
+        gmsh::model::addDiscreteEntity(2, tag);
+        gmsh::model::mesh::addNodes(2, tag, surfaceNodeTags, surfaceCoords);
+      }
+      for(size_t k = 0; k < numInterfaces; k++)
+      {
+        std::vector<std::size_t> triangleTags;
+        std::vector<std::size_t> triangleNodeTags;
+        for(size_t t = faceOffsets[k]; t < faceOffsets[k + 1]; t++)
+        {
+          const MeshIndexType* tri = triangles + 3 * faceList[t];
+          triangleTags.push_back(t + 1);
+          triangleNodeTags.push_back(tri[0] + 1);
+          triangleNodeTags.push_back(tri[1] + 1);
+          triangleNodeTags.push_back(tri[2] + 1);
+        }
+        gmsh::model::mesh::addElementsByType(static_cast<int>(k + 1), 2, triangleTags, triangleNodeTags);
+      }
+      for(size_t i = 1; i < numfeatures; i++)
+      {
+        if(surfaceLoops[i].empty())
+        {
+          continue;
+        }
+        int tag = static_cast<int>(i);
+        gmsh::model::geo::addSurfaceLoop(surfaceLoops[i], tag);
+        gmsh::model::geo::addVolume({tag}, tag);
+        hasVolume[i] = 1;
+      }
+    }
+    else
+    {
+      // Same model as the .geo file: every feature is a discrete surface with its own copy of the boundary
+      // vertices (as if merged from its STL file) and a volume bounded by that surface. Side 1 of a face
+      // belongs to the second feature and is added with the reverse winding.
+      std::vector<size_t> stamp(numNodes, 0);
+      std::vector<std::size_t> localTag(numNodes, 0);
+      std::size_t nextNodeTag = 1;
+      std::size_t nextElementTag = 1;
+      for(size_t i = 1; i < numfeatures; i++)
+      {
+        if(faceOffsets[i] == faceOffsets[i + 1])
+        {
+          continue;
+        }
+        std::vector<std::size_t> surfaceNodeTags;
+        std::vector<double> surfaceCoords;
+        std::vector<std::size_t> triangleTags;
+        std::vector<std::size_t> triangleNodeTags;
+        for(size_t k = faceOffsets[i]; k < faceOffsets[i + 1]; k++)
+        {
+          const MeshIndexType* tri = triangles + 3 * (faceList[k] >> 1);
+          bool reversed = (faceList[k] & 1) != 0;
+          MeshIndexType corners[3] = {tri[0], reversed ? tri[2] : tri[1], reversed ? tri[1] : tri[2]};
+          for(MeshIndexType c : corners)
+          {
+            if(stamp[c] != i)
+            {
+              stamp[c] = i;
+              localTag[c] = nextNodeTag++;
+              surfaceNodeTags.push_back(localTag[c]);
+              surfaceCoords.push_back(nodes[3 * c]);
+              surfaceCoords.push_back(nodes[3 * c + 1]);
+              surfaceCoords.push_back(nodes[3 * c + 2]);
+            }
+            triangleNodeTags.push_back(localTag[c]);
+          }
+          triangleTags.push_back(nextElementTag++);
+        }
+
+        int tag = static_cast<int>(i);
+        gmsh::model::addDiscreteEntity(2, tag);
+        gmsh::model::mesh::addNodes(2, tag, surfaceNodeTags, surfaceCoords);
+        gmsh::model::mesh::addElementsByType(tag, 2, triangleTags, triangleNodeTags);
+        gmsh::model::geo::addSurfaceLoop({tag}, tag);
+        gmsh::model::geo::addVolume({tag}, tag);
+        hasVolume[i] = 1;
+      }
+    }
+    gmsh::model::geo::synchronize();
+
+    if(m_UseFeatureSizeField)
+    {
+      // Same size field as the .geo file
+      std::vector<double> maxVolumes = getFeatureMaxVolumes(numfeatures);
+      std::vector<double> fields;
+      gmsh::option::setNumber("Mesh.MeshSizeExtendFromBoundary", 0);
+      gmsh::option::setNumber("Mesh.MeshSizeFromPoints", 0);
+      for(size_t i = 1; i < numfeatures; i++)
+      {
+        if(hasVolume[i] == 0 || maxVolumes[i] <= 0.0)
+        {
+          continue;
+        }
+        int tag = static_cast<int>(i);
+        gmsh::model::mesh::field::add("Constant", tag);
+        gmsh::model::mesh::field::setNumber(tag, "VIn", GmshMeshSize(maxVolumes[i]));
+        gmsh::model::mesh::field::setNumber(tag, "VOut", 1e22);
+        gmsh::model::mesh::field::setNumbers(tag, "VolumesList", {static_cast<double>(i)});
+        fields.push_back(static_cast<double>(i));
+      }
+      if(!fields.empty())
+      {
+        int tag = static_cast<int>(numfeatures);
+        gmsh::model::mesh::field::add("Min", tag);
+        gmsh::model::mesh::field::setNumbers(tag, "FieldsList", fields);
+        gmsh::model::mesh::field::setAsBackgroundMesh(tag);
+      }
+    }
+
+    gmsh::model::mesh::generate(3);
+
+    if(m_MeshFileFormat == 1)
+    {
+      QString gmshInpFile = m_WorkingDirectory + QDir::separator() + "gmsh.inp";
+      gmsh::write(gmshInpFile.toStdString());
+    }
+
+    // Volume i is feature i; 4 is Gmsh's element type of a linear tetrahedron
+    std::vector<double> parametricCoords;
+    gmsh::model::mesh::getNodes(nodeTags, coords, parametricCoords);
+    gmsh::model::mesh::getMaxNodeTag(maxNodeTag);
+    for(size_t i = 1; i < numfeatures; i++)
+    {
+      if(hasVolume[i] == 0)
+      {
+        continue;
+      }
+      std::vector<std::size_t> elementTags;
+      gmsh::model::mesh::getElementsByType(4, elementTags, tetNodeTags[i], static_cast<int>(i));
+    }
+  } catch(const std::exception& e)
+  {
+    gmshError = QString::fromStdString(e.what());
+  } catch(const std::string& e)
+  {
+    gmshError = QString::fromStdString(e);
+  } catch(...)
+  {
+    gmshError = "unknown error";
+  }
+  if(initialized)
+  {
+    gmsh::finalize();
+  }
+  gmshLock.unlock();
+
+  if(!gmshError.isEmpty())
   {
-    bufEle = inStreamEle.readLine();
-    bufEle = bufEle.trimmed();
-    bufEle = bufEle.simplified();
-    tokensEle = bufEle.split(' ');
-    tets[4 * i] = tokensEle[1].toInt(&ok) - 1;
-    tets[4 * i + 1] = tokensEle[2].toInt(&ok) - 1;
-    tets[4 * i + 2] = tokensEle[3].toInt(&ok) - 1;
-    tets[4 * i + 3] = tokensEle[4].toInt(&ok) - 1;
+    QString ss = QObject::tr("Gmsh failed to mesh the surface mesh: %1").arg(gmshError);
+    setErrorCondition(-4022, ss);
+    return;
+  }
 
-    int32_t value = tokensEle[5].toInt(&ok);
-    featureIDsdata->setComponent(i, 0, value);
+  // Node tags are not necessarily contiguous
+  size_t numVerts = nodeTags.size();
+  std::vector<MeshIndexType> nodeIndices(maxNodeTag + 1, std::numeric_limits<MeshIndexType>::max());
+  for(size_t i = 0; i < numVerts; i++)
+  {
+    nodeIndices[nodeTags[i]] = static_cast<MeshIndexType>(i);
+  }
 
-    int32_t pvalue = m_FeaturePhases[value];
-    phasesdata->setComponent(i, 0, pvalue);
+  size_t numCells = 0;
+  for(const std::vector<std::size_t>& featureTets : tetNodeTags)
+  {
+    numCells += featureTets.size() / 4;
+  }
 
-    for(size_t j = 0; j < 3; j++)
+  Int32ArrayType::Pointer featureIDsdata = allocateVolumeMesh(dataContainer, vertexAttrMat, cellAttrMat, numVerts, numCells);
+  if(nullptr == featureIDsdata.get())
+  {
+    return;
+  }
+  TetrahedralGeom::Pointer tetGeomPtr = dataContainer->getGeometryAs<TetrahedralGeom>();
+
+  float* tetvertex = tetGeomPtr->getVertexPointer(0);
+  for(size_t i = 0; i < 3 * numVerts; i++)
+  {
+    tetvertex[i] = static_cast<float>(coords[i]);
+  }
+
+  int32_t* featureIdPtr = featureIDsdata->getPointer(0);
+  MeshIndexType* tets = tetGeomPtr->getTetPointer(0);
+  size_t cell = 0;
+  for(size_t i = 1; i < numfeatures; i++)
+  {
+    const std::vector<std::size_t>& featureTets = tetNodeTags[i];
+    for(size_t k = 0; k + 3 < featureTets.size(); k += 4)
     {
-      float evalue = m_FeatureEulerAngles[3 * value + j];
-      eulerangles->setComponent(i, j, evalue);
+      for(size_t j = 0; j < 4; j++)
+      {
+        tets[4 * cell + j] = nodeIndices[featureTets[k + j]];
+      }
+      featureIdPtr[cell] = static_cast<int32_t>(i);
+      cell++;
     }
   }
+
+  createCellData(cellAttrMat, featureIDsdata);
+
+  notifyStatusMessage("Finished running Gmsh");
+#else
+  Q_UNUSED(triangleGeom)
+  Q_UNUSED(numfeatures)
+  Q_UNUSED(dataContainer)
+  Q_UNUSED(vertexAttrMat)
+  Q_UNUSED(cellAttrMat)
+#endif
 }
 
 // -----------------------------------------------------------------------------
@@ -4,20 +4,26 @@
 
 #pragma once
 
-#include <QtCore/QMutex>
+#include <memory>
+#include <vector>
+
 #include <QtCore/QProcess>
-#include <QtCore/QSharedPointer>
 #include <QtCore/QString>
-#include <QtCore/QWaitCondition>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+#include "SIMPLib/DataContainers/DataContainer.h"
 #include "SIMPLib/FilterParameters/FloatVec3FilterParameter.h"
 #include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
+#include "SIMPLib/Geometry/TriangleGeom.h"
 #include "SIMPLib/SIMPLib.h"
 
-class QProcess;
+namespace SimulationIO
+{
+class ScratchStorage;
+}
 
 #include "SimulationIO/SimulationIOPlugin.h"
 
@@ -35,6 +41,7 @@ class SimulationIO_EXPORT Export3dSolidMesh : public AbstractFilter
   PYB11_PROPERTY(DataArrayPath FeaturePhasesArrayPath READ getFeaturePhasesArrayPath WRITE setFeaturePhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath FeatureEulerAnglesArrayPath READ getFeatureEulerAnglesArrayPath WRITE setFeatureEulerAnglesArrayPath)
   PYB11_PROPERTY(DataArrayPath FeatureCentroidArrayPath READ getFeatureCentroidArrayPath WRITE setFeatureCentroidArrayPath)
+  PYB11_PROPERTY(DataArrayPath FeatureVolumesArrayPath READ getFeatureVolumesArrayPath WRITE setFeatureVolumesArrayPath)
 
   PYB11_PROPERTY(bool RefineMesh READ getRefineMesh WRITE setRefineMesh)
   PYB11_PROPERTY(float MaxRadiusEdgeRatio READ getMaxRadiusEdgeRatio WRITE setMaxRadiusEdgeRatio)
@@ -42,6 +49,7 @@ class SimulationIO_EXPORT Export3dSolidMesh : public AbstractFilter
   PYB11_PROPERTY(bool LimitTetrahedraVolume READ getLimitTetrahedraVolume WRITE setLimitTetrahedraVolume)
   PYB11_PROPERTY(float MaxTetrahedraVolume READ getMaxTetrahedraVolume WRITE setMaxTetrahedraVolume)
   PYB11_PROPERTY(int OptimizationLevel READ getOptimizationLevel WRITE setOptimizationLevel)
+  PYB11_PROPERTY(bool UseTetGenLibrary READ getUseTetGenLibrary WRITE setUseTetGenLibrary)
 
   PYB11_PROPERTY(QString TetDataContainerName READ getTetDataContainerName WRITE setTetDataContainerName)
   PYB11_PROPERTY(QString VertexAttributeMatrixName READ getVertexAttributeMatrixName WRITE setVertexAttributeMatrixName)
@@ -49,9 +57,20 @@ class SimulationIO_EXPORT Export3dSolidMesh : public AbstractFilter
 
   PYB11_PROPERTY(QString GmshSTLFileName READ getGmshSTLFileName WRITE setGmshSTLFileName)
   PYB11_PROPERTY(int MeshFileFormat READ getMeshFileFormat WRITE setMeshFileFormat)
+  PYB11_PROPERTY(int GmshNumThreads READ getGmshNumThreads WRITE setGmshNumThreads)
+  PYB11_PROPERTY(int GmshAlgorithm3D READ getGmshAlgorithm3D WRITE setGmshAlgorithm3D)
+  PYB11_PROPERTY(bool UseGmshLibrary READ getUseGmshLibrary WRITE setUseGmshLibrary)
+  PYB11_PROPERTY(bool ConformalMesh READ getConformalMesh WRITE setConformalMesh)
+  PYB11_PROPERTY(bool PreconditionSurfaceMesh READ getPreconditionSurfaceMesh WRITE setPreconditionSurfaceMesh)
+  PYB11_PROPERTY(float WeldTolerance READ getWeldTolerance WRITE setWeldTolerance)
+  PYB11_PROPERTY(float TargetEdgeLength READ getTargetEdgeLength WRITE setTargetEdgeLength)
+  PYB11_PROPERTY(bool UseFeatureSizeField READ getUseFeatureSizeField WRITE setUseFeatureSizeField)
+  PYB11_PROPERTY(int TetrahedraPerFeature READ getTetrahedraPerFeature WRITE setTetrahedraPerFeature)
+  PYB11_PROPERTY(bool OutOfCoreMesh READ getOutOfCoreMesh WRITE setOutOfCoreMesh)
 
   PYB11_PROPERTY(QString NetgenSTLFileName READ getNetgenSTLFileName WRITE setNetgenSTLFileName)
   PYB11_PROPERTY(int MeshSize READ getMeshSize WRITE setMeshSize)
+  PYB11_PROPERTY(int MaxNetgenProcesses READ getMaxNetgenProcesses WRITE setMaxNetgenProcesses)
 
 public:
   SIMPL_SHARED_POINTERS(Export3dSolidMesh)
@@ -81,6 +100,9 @@ public:
   SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureCentroidArrayPath)
   Q_PROPERTY(DataArrayPath FeatureCentroidArrayPath READ getFeatureCentroidArrayPath WRITE setFeatureCentroidArrayPath)
 
+  SIMPL_FILTER_PARAMETER(DataArrayPath, FeatureVolumesArrayPath)
+  Q_PROPERTY(DataArrayPath FeatureVolumesArrayPath READ getFeatureVolumesArrayPath WRITE setFeatureVolumesArrayPath)
+
   SIMPL_FILTER_PARAMETER(bool, RefineMesh)
   Q_PROPERTY(bool RefineMesh READ getRefineMesh WRITE setRefineMesh)
 
@@ -99,6 +121,9 @@ public:
   SIMPL_FILTER_PARAMETER(int, OptimizationLevel)
   Q_PROPERTY(int OptimizationLevel READ getOptimizationLevel WRITE setOptimizationLevel)
 
+  SIMPL_FILTER_PARAMETER(bool, UseTetGenLibrary)
+  Q_PROPERTY(bool UseTetGenLibrary READ getUseTetGenLibrary WRITE setUseTetGenLibrary)
+
   SIMPL_FILTER_PARAMETER(QString, TetDataContainerName)
   Q_PROPERTY(QString TetDataContainerName READ getTetDataContainerName WRITE setTetDataContainerName)
 
@@ -114,12 +139,45 @@ public:
   SIMPL_FILTER_PARAMETER(int, MeshFileFormat)
   Q_PROPERTY(int MeshFileFormat READ getMeshFileFormat WRITE setMeshFileFormat)
 
+  SIMPL_FILTER_PARAMETER(int, GmshNumThreads)
+  Q_PROPERTY(int GmshNumThreads READ getGmshNumThreads WRITE setGmshNumThreads)
+
+  SIMPL_FILTER_PARAMETER(int, GmshAlgorithm3D)
+  Q_PROPERTY(int GmshAlgorithm3D READ getGmshAlgorithm3D WRITE setGmshAlgorithm3D)
+
+  SIMPL_FILTER_PARAMETER(bool, UseGmshLibrary)
+  Q_PROPERTY(bool UseGmshLibrary READ getUseGmshLibrary WRITE setUseGmshLibrary)
+
+  SIMPL_FILTER_PARAMETER(bool, ConformalMesh)
+  Q_PROPERTY(bool ConformalMesh READ getConformalMesh WRITE setConformalMesh)
+
+  SIMPL_FILTER_PARAMETER(bool, PreconditionSurfaceMesh)
+  Q_PROPERTY(bool PreconditionSurfaceMesh READ getPreconditionSurfaceMesh WRITE setPreconditionSurfaceMesh)
+
+  SIMPL_FILTER_PARAMETER(float, WeldTolerance)
+  Q_PROPERTY(float WeldTolerance READ getWeldTolerance WRITE setWeldTolerance)
+
+  SIMPL_FILTER_PARAMETER(float, TargetEdgeLength)
+  Q_PROPERTY(float TargetEdgeLength READ getTargetEdgeLength WRITE setTargetEdgeLength)
+
+  SIMPL_FILTER_PARAMETER(bool, UseFeatureSizeField)
+  Q_PROPERTY(bool UseFeatureSizeField READ getUseFeatureSizeField WRITE setUseFeatureSizeField)
+
+  SIMPL_FILTER_PARAMETER(int, TetrahedraPerFeature)
+  Q_PROPERTY(int TetrahedraPerFeature READ getTetrahedraPerFeature WRITE setTetrahedraPerFeature)
+
+  SIMPL_FILTER_PARAMETER(bool, OutOfCoreMesh)
+  Q_PROPERTY(bool OutOfCoreMesh READ getOutOfCoreMesh WRITE setOutOfCoreMesh)
+
   SIMPL_FILTER_PARAMETER(QString, NetgenSTLFileName)
   Q_PROPERTY(QString NetgenSTLFileName READ getNetgenSTLFileName WRITE setNetgenSTLFileName)
 
   SIMPL_FILTER_PARAMETER(int, MeshSize)
   Q_PROPERTY(int MeshSize READ getMeshSize WRITE setMeshSize)
 
+  SIMPL_FILTER_PARAMETER(int, MaxNetgenProcesses)
+  Q_PROPERTY(int MaxNetgenProcesses READ getMaxNetgenProcesses WRITE setMaxNetgenProcesses)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -222,30 +280,167 @@ protected:
    */
   void initialize();
 
-protected slots:
-  void processHasFinished(int exitCode, QProcess::ExitStatus exitStatus);
-  void processHasErroredOut(QProcess::ProcessError error);
-  void sendErrorOutput();
-  void sendStandardOutput();
-
 private:
   DEFINE_DATAARRAY_VARIABLE(float, FeatureEulerAngles)
   DEFINE_DATAARRAY_VARIABLE(float, FeatureCentroid)
+  DEFINE_DATAARRAY_VARIABLE(float, FeatureVolumes)
   DEFINE_DATAARRAY_VARIABLE(int32_t, FeaturePhases)
+  DEFINE_DATAARRAY_VARIABLE(int32_t, SurfaceMeshFaceLabels)
 
+  /**
+   * @brief runPackage Runs the TetGen or Gmsh executable on file in the output directory and passes its output on
+   * as status messages
+   */
   void runPackage(const QString& file, const QString& meshFile);
-  void mergeMesh(const QString& mergefile, const QString& indivFile);
+
+  /**
+   * @brief runNetgenJobs Meshes every input file with its own Netgen process. Up to MaxNetgenProcesses processes
+   * run at the same time, each in its own working directory next to its mesh file. Output of every process goes
+   * to a netgen.log file in that directory, which is only kept if the job fails. All processes are killed when the
+   * filter is canceled or a job fails.
+   * @param inputFiles Absolute paths of the STL files
+   * @param meshFiles Absolute paths of the .vol files to create, one per input file
+   */
+  void runNetgenJobs(const QStringList& inputFiles, const QStringList& meshFiles);
+
+  /**
+   * @brief getNetgenArguments Returns the Netgen command line that meshes file into meshFile
+   */
+  QStringList getNetgenArguments(const QString& file, const QString& meshFile) const;
+
+  /**
+   * @brief getPackageProgram Returns the absolute path of a package executable in PackageLocation, or just its
+   * name (looked up in PATH) if no location is set
+   */
+  QString getPackageProgram(const QString& name) const;
+
+  /**
+   * @brief getNetgenEnvironment Returns the process environment Netgen needs (on macOS it has to find its bundled libraries)
+   */
+  QProcessEnvironment getNetgenEnvironment() const;
+
+  /**
+   * @brief preconditionSurfaceMesh Returns a copy of the surface mesh with duplicate vertices welded, degenerate
+   * triangles removed and, with a target edge length, the boundary patches decimated (see SurfaceMeshPreconditioner)
+   * @param triangleGeom Surface mesh
+   * @param faceLabels Receives the face labels of the copy
+   */
+  TriangleGeom::Pointer preconditionSurfaceMesh(TriangleGeom* triangleGeom, Int32ArrayType::Pointer& faceLabels);
+
+  /**
+   * @brief writeFeatureStlFiles Writes the surface of every feature to a binary STL file, the input of Netgen and
+   * Gmsh. The faces are split by the face labels in one pass; a face whose second label is the feature is written
+   * reversed, so each side of a shared boundary gets its own winding.
+   * @param triangleGeom Surface mesh
+   * @param stlFiles Files to create; the file of feature i is stlFiles[i - 1]
+   */
+  void writeFeatureStlFiles(TriangleGeom* triangleGeom, const QStringList& stlFiles);
+
+  /**
+   * @brief writeInterfaceMeshFile Writes the grain boundaries of the surface mesh to a binary Gmsh MSH 4.1 file, the
+   * input of the conformal Gmsh mode. Interface k becomes discrete surface k + 1; the surfaces share their vertices,
+   * so every vertex is written once.
+   * @param triangleGeom Surface mesh
+   * @param faceOffsets Faces of every interface, see BucketFacesByInterface
+   * @param faceList
+   * @param file
+   */
+  void writeInterfaceMeshFile(TriangleGeom* triangleGeom, const std::vector<size_t>& faceOffsets, const std::vector<size_t>& faceList, const QString& file);
 
   void createTetgenInpFile(const QString& file, MeshIndexType numNodes, float* nodes, MeshIndexType numTri, MeshIndexType* triangles, size_t numfeatures, float* centroid);
 
-  QWaitCondition m_WaitCondition;
-  QMutex m_Mutex;
-  bool m_Pause = false;
-  QSharedPointer<QProcess> m_ProcessPtr;
-  QStringList arguments;
+  // Absolute path of the output directory for the current run
+  QString m_WorkingDirectory;
+
+  // Creates the scratch files of the out-of-core arrays of the current run; every array owns its file, so the
+  // arrays stay valid after the filter runs again or is deleted
+  std::shared_ptr<SimulationIO::ScratchStorage> m_ScratchStorage;
 
   void scanTetGenFile(const QString& fileEle, const QString& fileNode, DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix, AttributeMatrix* cellAttributeMatrix);
 
+  /**
+   * @brief scanVolumeMesh Reads the tetrahedra of a Netgen .vol or Gmsh .msh file into the output data container.
+   * The material (Netgen) or volume (Gmsh) number of each tetrahedron is taken as its feature id.
+   * @param file
+   * @param dataContainer Output data container with the tetrahedral geometry
+   * @param vertexAttributeMatrix
+   * @param cellAttributeMatrix
+   */
+  void scanVolumeMesh(const QString& file, DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix, AttributeMatrix* cellAttributeMatrix);
+
+  /**
+   * @brief getFeatureMaxVolumes Returns the largest tetrahedron volume allowed in every feature by the feature size
+   * field: the volume of the feature divided by TetrahedraPerFeature, or -1 (no limit) for features without volume
+   * @param numfeatures Number of features, including feature 0
+   */
+  std::vector<double> getFeatureMaxVolumes(size_t numfeatures) const;
+
+  /**
+   * @brief getTetGenSwitches Returns the TetGen command line switches for the current mesh quality options
+   */
+  QString getTetGenSwitches() const;
+
+  /**
+   * @brief runTetGenLibrary Meshes the surface mesh with the linked TetGen library. The input is filled from the
+   * triangle geometry in memory and the tetrahedra are copied straight into the output data container, so no files
+   * are written.
+   * @param triangleGeom Surface mesh
+   * @param numfeatures Number of features, including feature 0
+   * @param centroid Feature centroids, used as region seeds
+   * @param dataContainer Output data container with the tetrahedral geometry
+   * @param vertexAttributeMatrix
+   * @param cellAttributeMatrix
+   */
+  void runTetGenLibrary(TriangleGeom* triangleGeom, size_t numfeatures, float* centroid, DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix,
+                        AttributeMatrix* cellAttributeMatrix);
+
+  /**
+   * @brief getGmshThreadCount Returns the number of threads Gmsh is told to use (General.NumThreads)
+   */
+  int getGmshThreadCount() const;
+
+  /**
+   * @brief runGmshLibrary Meshes the features with the linked Gmsh library. Every feature becomes a discrete
+   * surface, built from its faces in memory, and a volume bounded by it, like the gmsh.geo file of the executable
+   * mode. With ConformalMesh every grain boundary becomes one discrete surface shared by the volumes on both sides.
+   * The tetrahedra are copied straight into the output data container; no .msh file is written. Gmsh has a single,
+   * process-wide state, so only one in-process Gmsh run is active at a time; others wait for it.
+   * @param triangleGeom Surface mesh
+   * @param numfeatures Number of features, including feature 0
+   * @param dataContainer Output data container with the tetrahedral geometry
+   * @param vertexAttributeMatrix
+   * @param cellAttributeMatrix
+   */
+  void runGmshLibrary(TriangleGeom* triangleGeom, size_t numfeatures, DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix, AttributeMatrix* cellAttributeMatrix);
+
+  /**
+   * @brief allocateVolumeMesh Sizes the tetrahedral geometry and both attribute matrices for a volume mesh and
+   * creates the FeatureIDs array. With OutOfCoreMesh the tetrahedra, vertices and FeatureIDs live in scratch files.
+   * @param dataContainer Output data container with the tetrahedral geometry
+   * @param vertexAttributeMatrix
+   * @param cellAttributeMatrix
+   * @param numVertices
+   * @param numTetrahedra
+   * @return The FeatureIDs array, or a null pointer on error
+   */
+  Int32ArrayType::Pointer allocateVolumeMesh(DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix, AttributeMatrix* cellAttributeMatrix, size_t numVertices,
+                                             size_t numTetrahedra);
+
+  /**
+   * @brief createMeshArray Creates a zero filled array for the volume mesh, in a scratch file with OutOfCoreMesh
+   * @return A null pointer on error
+   */
+  template <typename T>
+  typename DataArray<T>::Pointer createMeshArray(size_t numTuples, const std::vector<size_t>& cDims, const QString& name);
+
+  /**
+   * @brief createCellData Adds the feature ids of the tetrahedra to the cell attribute matrix, together with the
+   * Phases and Euler Angles of their features
+   * @param cellAttributeMatrix
+   * @param featureIds FeatureIDs array, one value per tetrahedron
+   */
+  void createCellData(AttributeMatrix* cellAttributeMatrix, const Int32ArrayType::Pointer& featureIds);
+
 public:
   /* Rule of 5: All special member functions should be defined if any are defined.
    * https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-default-operation-define-or-delete-them-all
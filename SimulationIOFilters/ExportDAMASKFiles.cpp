@@ -6,6 +6,12 @@
 
 #include "SIMPLib/Common/Constants.h"
 
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
 #include <QtCore/QDir>
 
 #include "SIMPLib/Common/Constants.h"
@@ -30,6 +36,9 @@
 #include "SIMPLib/Utilities/FileSystemPathHelper.h"
 
 #include "SimulationIO/SimulationIOConstants.h"
+#include "SimulationIO/SimulationIOFilters/util/ChunkedTextWriter.hpp"
+#include "SimulationIO/SimulationIOFilters/util/TextFormatting.hpp"
+#include "SimulationIO/SimulationIOFilters/util/VtkAppendedDataWriter.hpp"
 #include "SimulationIO/SimulationIOVersion.h"
 
 // -----------------------------------------------------------------------------
@@ -39,11 +48,13 @@ ExportDAMASKFiles::ExportDAMASKFiles()
 : m_DataFormat(0)
 , m_OutputPath("")
 , m_GeometryFileName("")
+, m_GeometryFileFormat(0)
 , m_HomogenizationIndex(1)
 , m_FeatureIdsArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::FeatureIds)
 , m_CellPhasesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::Phases)
 , m_CellEulerAnglesArrayPath(SIMPL::Defaults::ImageDataContainerName, SIMPL::Defaults::CellAttributeMatrixName, SIMPL::CellData::EulerAngles)
 , m_CompressGeomFile(true)
+, m_MergeIdenticalOrientations(false)
 
 {
   initialize();
@@ -80,7 +91,7 @@ void ExportDAMASKFiles::setupFilterParameters()
     choices.push_back("pointwise");
     choices.push_back("grainwise");
     parameter->setChoices(choices);
-    QStringList linkedProps = {"CompressGeomFile"};
+    QStringList linkedProps = {"MergeIdenticalOrientations"};
     parameter->setLinkedProperties(linkedProps);
     parameter->setEditable(false);
     parameter->setCategory(FilterParameter::Parameter);
@@ -89,10 +100,25 @@ void ExportDAMASKFiles::setupFilterParameters()
 
   parameters.push_back(SIMPL_NEW_OUTPUT_PATH_FP("Output Path ", OutputPath, FilterParameter::Parameter, ExportDAMASKFiles, "*", "*"));
   parameters.push_back(SIMPL_NEW_STRING_FP("Geometry File Name", GeometryFileName, FilterParameter::Parameter, ExportDAMASKFiles));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Geometry File Format");
+    parameter->setPropertyName("GeometryFileFormat");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(ExportDAMASKFiles, this, GeometryFileFormat));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(ExportDAMASKFiles, this, GeometryFileFormat));
+
+    QVector<QString> choices;
+    choices.push_back("geom (ASCII)");
+    choices.push_back("vtr (VTK Rectilinear Grid)");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
 
   parameters.push_back(SIMPL_NEW_INTEGER_FP("Homogenization Index", HomogenizationIndex, FilterParameter::Parameter, ExportDAMASKFiles));
 
-  parameters.push_back(SIMPL_NEW_BOOL_FP("Compress Geom File", CompressGeomFile, FilterParameter::Parameter, ExportDAMASKFiles, 0));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Compress Geom File", CompressGeomFile, FilterParameter::Parameter, ExportDAMASKFiles));
+  parameters.push_back(SIMPL_NEW_BOOL_FP("Merge Identical Orientations", MergeIdenticalOrientations, FilterParameter::Parameter, ExportDAMASKFiles, 0));
 
   parameters.push_back(SeparatorFilterParameter::New("Cell Data", FilterParameter::RequiredArray));
   {
@@ -121,8 +147,10 @@ void ExportDAMASKFiles::readFilterParameters(AbstractFilterParametersReader* rea
   setDataFormat(reader->readValue("DataFormat", getDataFormat()));
   setOutputPath(reader->readString("OutputPath", getOutputPath()));
   setGeometryFileName(reader->readString("GeometryFileName", getGeometryFileName()));
+  setGeometryFileFormat(reader->readValue("GeometryFileFormat", getGeometryFileFormat()));
   setHomogenizationIndex(reader->readValue("HomogenizationIndex", getHomogenizationIndex()));
   setCompressGeomFile(reader->readValue("CompressGeomFile", getCompressGeomFile()));
+  setMergeIdenticalOrientations(reader->readValue("MergeIdenticalOrientations", getMergeIdenticalOrientations()));
   setCellEulerAnglesArrayPath(reader->readDataArrayPath("CellEulerAnglesArrayPath", getCellEulerAnglesArrayPath()));
   setCellPhasesArrayPath(reader->readDataArrayPath("CellPhasesArrayPath", getCellPhasesArrayPath()));
   setFeatureIdsArrayPath(reader->readDataArrayPath("FeatureIdsArrayPath", getFeatureIdsArrayPath()));
@@ -212,10 +240,23 @@ void ExportDAMASKFiles::execute()
   }
   //
   //
-  QString geomFile = m_OutputPath + QDir::separator() + m_GeometryFileName + ".geom";
+  QString geomFile = m_OutputPath + QDir::separator() + m_GeometryFileName + (m_GeometryFileFormat == 1 ? ".vtr" : ".geom");
   QString matFile = m_OutputPath + QDir::separator() + "material.config";
   FILE* geomf = fopen(geomFile.toLatin1().data(), "wb");
+  if(nullptr == geomf)
+  {
+    QString ss = QObject::tr("Error opening output file '%1'").arg(geomFile);
+    setErrorCondition(-1, ss);
+    return;
+  }
   FILE* matf = fopen(matFile.toLatin1().data(), "wb");
+  if(nullptr == matf)
+  {
+    fclose(geomf);
+    QString ss = QObject::tr("Error opening output file '%1'").arg(matFile);
+    setErrorCondition(-1, ss);
+    return;
+  }
   //
   //
   DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getFeatureIdsArrayPath().getDataContainerName());
@@ -241,73 +282,65 @@ void ExportDAMASKFiles::execute()
       maxGrainId = m_FeatureIds[i];
     }
   }
+
+  // Pointwise cells with the same phase and orientation can share one texture and microstructure entry
+  bool mergePoints = (m_DataFormat == 0 && m_MergeIdenticalOrientations);
+  std::vector<int32_t> pointIds;
+  std::vector<int32_t> uniquePhases;
+  std::vector<int32_t> uniqueEulers;
+  if(mergePoints)
+  {
+    findUniqueOrientations(static_cast<size_t>(totalPoints), pointIds, uniquePhases, uniqueEulers);
+  }
+  const int32_t* microstructureIds = nullptr;
+  if(m_DataFormat == 1)
+  {
+    microstructureIds = m_FeatureIds;
+  }
+  else if(mergePoints)
+  {
+    microstructureIds = pointIds.data();
+  }
   //
   //
-  fprintf(geomf, "6       header\n");
-  fprintf(geomf, "# Generated by DREAM.3D\n");
-  fprintf(geomf, "grid    a %zu    b %zu    c %zu\n", dims[0], dims[1], dims[2]);
-  fprintf(geomf, "size    x %.3f    y %.3f    z %.3f\n", size[0], size[1], size[2]);
-  fprintf(geomf, "origin    x %.3f    y %.3f    z %.3f\n", origin[0], origin[1], origin[2]);
-  fprintf(geomf, "homogenization  %d\n", m_HomogenizationIndex);
-
-  switch(m_DataFormat)
+  bool geomWritten = false;
+  if(m_GeometryFileFormat == 1)
   {
-  case 0: // pointwise
+    geomWritten = writeVtrGeometry(geomf, dims, spacing, origin, microstructureIds, static_cast<size_t>(totalPoints));
+  }
+  else
   {
-    fprintf(geomf, "microstructures %d\n", totalPoints);
-
-    if(m_CompressGeomFile)
+    fprintf(geomf, "6       header\n");
+    fprintf(geomf, "# Generated by DREAM.3D\n");
+    fprintf(geomf, "grid    a %zu    b %zu    c %zu\n", dims[0], dims[1], dims[2]);
+    fprintf(geomf, "size    x %.3f    y %.3f    z %.3f\n", size[0], size[1], size[2]);
+    fprintf(geomf, "origin    x %.3f    y %.3f    z %.3f\n", origin[0], origin[1], origin[2]);
+    fprintf(geomf, "homogenization  %d\n", m_HomogenizationIndex);
+
+    switch(m_DataFormat)
     {
-      fprintf(geomf, "1 to %10d", totalPoints);
-    }
-    else
+    case 0: // pointwise
     {
-      int32_t entriesPerLine = 0;
-      for(int32_t i = 1; i <= totalPoints; i++)
-      {
-        if(entriesPerLine != 0)
-        {
-          if((entriesPerLine % 10) != 0) // 10 per line
-          {
-            fprintf(geomf, " ");
-          }
-          else
-          {
-            fprintf(geomf, "\n");
-            entriesPerLine = 0;
-          }
-        }
-        fprintf(geomf, "%10d", i);
-        entriesPerLine++;
-      }
+      fprintf(geomf, "microstructures %d\n", mergePoints ? static_cast<int32_t>(uniquePhases.size()) : totalPoints);
+      break;
     }
-    break;
-  }
-  case 1: // grainwise
-  {
-    fprintf(geomf, "microstructures %d\n", maxGrainId);
-
-    int32_t entriesPerLine = 0;
-    for(int32_t i = 0; i < totalPoints; i++)
+    case 1: // grainwise
     {
-      if(entriesPerLine != 0)
-      {
-        if((entriesPerLine % 10) != 0) // 10 per line
-        {
-          fprintf(geomf, " ");
-        }
-        else
-        {
-          fprintf(geomf, "\n");
-          entriesPerLine = 0;
-        }
-      }
-      fprintf(geomf, "%10d", m_FeatureIds[i]);
-      entriesPerLine++;
-      //
+      fprintf(geomf, "microstructures %d\n", maxGrainId);
+      break;
     }
-    break;
+    }
+
+    size_t chunkSize = std::min<size_t>(std::max<size_t>(dims[0] * dims[1], 4096), 262144);
+    geomWritten = writeGeomMicrostructures(geomf, microstructureIds, static_cast<size_t>(totalPoints), chunkSize);
   }
+  if(!geomWritten)
+  {
+    fclose(geomf);
+    fclose(matf);
+    QString ss = QObject::tr("Error writing output file '%1'").arg(geomFile);
+    setErrorCondition(-1, ss);
+    return;
   }
 
   //
@@ -323,6 +356,25 @@ void ExportDAMASKFiles::execute()
   {
   case 0: // pointwise
   {
+    if(mergePoints)
+    {
+      int32_t numUnique = static_cast<int32_t>(uniquePhases.size());
+      fprintf(matf, "<texture>\n");
+      for(int32_t i = 0; i < numUnique; i++)
+      {
+        fprintf(matf, "[orientation%d]\n", i + 1);
+        fprintf(matf, "(gauss) phi1 %.3f   Phi %.3f    phi2 %.3f   scatter 0.0   fraction 1.0 \n", uniqueEulers[i * 3] * 0.001, uniqueEulers[i * 3 + 1] * 0.001, uniqueEulers[i * 3 + 2] * 0.001);
+      }
+
+      fprintf(matf, "<microstructure>\n");
+      for(int32_t i = 0; i < numUnique; i++)
+      {
+        fprintf(matf, "[orientation%d]\n", i + 1);
+        fprintf(matf, "crystallite 1\n");
+        fprintf(matf, "(constituent)   phase %d texture %d fraction 1.0\n", uniquePhases[i], i + 1);
+      }
+      break;
+    }
 
     fprintf(matf, "<texture>\n");
     for(int32_t i = 0; i < totalPoints; i++)
@@ -408,6 +460,257 @@ void ExportDAMASKFiles::execute()
   //
 }
 
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExportDAMASKFiles::findUniqueOrientations(size_t totalPoints, std::vector<int32_t>& cellIds, std::vector<int32_t>& phases, std::vector<int32_t>& eulerAngles)
+{
+  struct OrientationKey
+  {
+    int32_t phase;
+    int32_t angles[3];
+
+    bool operator==(const OrientationKey& other) const
+    {
+      return phase == other.phase && angles[0] == other.angles[0] && angles[1] == other.angles[1] && angles[2] == other.angles[2];
+    }
+  };
+  struct OrientationKeyHash
+  {
+    size_t operator()(const OrientationKey& key) const
+    {
+      uint64_t h = static_cast<uint32_t>(key.phase);
+      for(int32_t angle : key.angles)
+      {
+        h = (h ^ static_cast<uint32_t>(angle)) * 0x100000001B3ULL;
+      }
+      return static_cast<size_t>(h ^ (h >> 32));
+    }
+  };
+
+  cellIds.resize(totalPoints);
+  phases.clear();
+  eulerAngles.clear();
+
+  std::unordered_map<OrientationKey, int32_t, OrientationKeyHash> uniqueIds;
+  const double k_RadToMilliDegrees = 180.0 * SIMPLib::Constants::k_1OverPi * 1000.0;
+  for(size_t i = 0; i < totalPoints; i++)
+  {
+    OrientationKey key;
+    key.phase = m_CellPhases[i];
+    for(size_t c = 0; c < 3; c++)
+    {
+      key.angles[c] = static_cast<int32_t>(std::lround(m_CellEulerAngles[i * 3 + c] * k_RadToMilliDegrees));
+    }
+
+    auto inserted = uniqueIds.insert({key, static_cast<int32_t>(phases.size()) + 1});
+    if(inserted.second)
+    {
+      phases.push_back(key.phase);
+      eulerAngles.insert(eulerAngles.end(), key.angles, key.angles + 3);
+    }
+    cellIds[i] = inserted.first->second;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExportDAMASKFiles::writeGeomMicrostructures(FILE* f, const int32_t* ids, size_t totalPoints, size_t chunkSize)
+{
+  SimulationIO::ChunkedTextWriter writer(f);
+  writer.setChunkSize(chunkSize);
+
+  if(nullptr == ids && m_CompressGeomFile)
+  {
+    fprintf(f, "1 to %10llu", static_cast<unsigned long long>(totalPoints));
+    return ferror(f) == 0;
+  }
+
+  if(m_CompressGeomFile)
+  {
+    return writer.write(totalPoints, [ids](std::string& buffer, size_t start, size_t end) { AppendCompressedMicrostructures(buffer, ids, start, end); });
+  }
+
+  // 10 right aligned entries per line, without ids the index of a cell is its position in the list
+  return writer.write(totalPoints, [ids](std::string& buffer, size_t start, size_t end) {
+    buffer.resize((end - start) * 12);
+    char* out = &buffer[0];
+    char* p = out;
+    for(size_t i = start; i < end; i++)
+    {
+      if(i != 0)
+      {
+        *p++ = (i % 10 == 0) ? '\n' : ' ';
+      }
+      int64_t value = (nullptr == ids) ? static_cast<int64_t>(i) + 1 : ids[i];
+      p = SimulationIO::TextFormatting::FormatPaddedInt(p, value, 10);
+    }
+    buffer.resize(static_cast<size_t>(p - out));
+  });
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExportDAMASKFiles::AppendCompressedMicrostructures(std::string& buffer, const int32_t* ids, size_t start, size_t end)
+{
+  // Runs and ranges must be on a line of their own, so they end the current line of single entries
+  const size_t k_MinRunLength = 3;
+  const size_t k_EntriesPerLine = 10;
+
+  char tmp[3 * SimulationIO::TextFormatting::k_MaxCharsPerValue];
+  size_t entriesOnLine = 0;
+
+  size_t i = start;
+  while(i < end)
+  {
+    int32_t value = ids[i];
+
+    size_t j = i + 1;
+    while(j < end && ids[j] == value)
+    {
+      j++;
+    }
+    bool isRun = (j - i >= k_MinRunLength);
+    if(!isRun)
+    {
+      j = i + 1;
+      while(j < end && static_cast<int64_t>(ids[j]) == static_cast<int64_t>(ids[j - 1]) + 1)
+      {
+        j++;
+      }
+    }
+
+    if(j - i >= k_MinRunLength)
+    {
+      if(entriesOnLine > 0)
+      {
+        buffer.push_back('\n');
+        entriesOnLine = 0;
+      }
+      char* p = tmp;
+      if(isRun) // "n of x"
+      {
+        p = SimulationIO::TextFormatting::FormatUInt(p, j - i);
+        std::memcpy(p, " of ", 4);
+        p = SimulationIO::TextFormatting::FormatInt(p + 4, value);
+      }
+      else // "a to b"
+      {
+        p = SimulationIO::TextFormatting::FormatInt(p, value);
+        std::memcpy(p, " to ", 4);
+        p = SimulationIO::TextFormatting::FormatInt(p + 4, ids[j - 1]);
+      }
+      *p++ = '\n';
+      buffer.append(tmp, static_cast<size_t>(p - tmp));
+      i = j;
+      continue;
+    }
+
+    char* p = tmp;
+    if(entriesOnLine > 0)
+    {
+      *p++ = ' ';
+    }
+    p = SimulationIO::TextFormatting::FormatInt(p, value);
+    buffer.append(tmp, static_cast<size_t>(p - tmp));
+    entriesOnLine++;
+    if(entriesOnLine == k_EntriesPerLine)
+    {
+      buffer.push_back('\n');
+      entriesOnLine = 0;
+    }
+    i++;
+  }
+
+  if(entriesOnLine > 0)
+  {
+    buffer.push_back('\n');
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExportDAMASKFiles::writeVtrGeometry(FILE* f, const SizeVec3Type& dims, const FloatVec3Type& spacing, const FloatVec3Type& origin, const int32_t* ids, size_t totalPoints)
+{
+  SimulationIO::VtkAppendedDataWriter writer(f, m_CompressGeomFile);
+
+  // The node coordinates are small, so they are encoded up front to know where the material array starts
+  QByteArray coords[3];
+  for(size_t d = 0; d < 3; d++)
+  {
+    std::vector<double> values(dims[d] + 1);
+    for(size_t i = 0; i <= dims[d]; i++)
+    {
+      values[i] = static_cast<double>(origin[d]) + static_cast<double>(i) * static_cast<double>(spacing[d]);
+    }
+    coords[d] = writer.encode(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double));
+  }
+
+  const char* axes[3] = {"x", "y", "z"};
+  size_t offset = 0;
+
+  fprintf(f, "<?xml version=\"1.0\"?>\n");
+  fprintf(f, "<VTKFile type=\"RectilinearGrid\" version=\"1.0\" byte_order=\"%s\" header_type=\"UInt64\"%s>\n", SimulationIO::VtkAppendedDataWriter::GetByteOrder(), writer.getCompressorAttribute());
+  fprintf(f, "  <RectilinearGrid WholeExtent=\"0 %zu 0 %zu 0 %zu\">\n", dims[0], dims[1], dims[2]);
+  fprintf(f, "    <FieldData>\n");
+  fprintf(f, "      <Array type=\"String\" Name=\"comments\" NumberOfTuples=\"1\" format=\"ascii\">\n");
+  // "Generated by DREAM.3D" as a null terminated list of character codes
+  QByteArray comment("Generated by DREAM.3D");
+  fprintf(f, "       ");
+  for(char c : comment)
+  {
+    fprintf(f, " %d", static_cast<int>(c));
+  }
+  fprintf(f, " 0\n");
+  fprintf(f, "      </Array>\n");
+  fprintf(f, "    </FieldData>\n");
+  fprintf(f, "    <Piece Extent=\"0 %zu 0 %zu 0 %zu\">\n", dims[0], dims[1], dims[2]);
+  fprintf(f, "      <PointData>\n");
+  fprintf(f, "      </PointData>\n");
+  fprintf(f, "      <CellData>\n");
+  fprintf(f, "        <DataArray type=\"Int32\" Name=\"material\" format=\"appended\" offset=\"%zu\"/>\n", offset + coords[0].size() + coords[1].size() + coords[2].size());
+  fprintf(f, "      </CellData>\n");
+  fprintf(f, "      <Coordinates>\n");
+  for(size_t d = 0; d < 3; d++)
+  {
+    fprintf(f, "        <DataArray type=\"Float64\" Name=\"%s\" format=\"appended\" offset=\"%zu\"/>\n", axes[d], offset);
+    offset += static_cast<size_t>(coords[d].size());
+  }
+  fprintf(f, "      </Coordinates>\n");
+  fprintf(f, "    </Piece>\n");
+  fprintf(f, "  </RectilinearGrid>\n");
+  fprintf(f, "  <AppendedData encoding=\"raw\">\n");
+  fprintf(f, "   _");
+
+  for(size_t d = 0; d < 3; d++)
+  {
+    if(fwrite(coords[d].constData(), 1, static_cast<size_t>(coords[d].size()), f) != static_cast<size_t>(coords[d].size()))
+    {
+      return false;
+    }
+  }
+
+  // DAMASK material indices are zero based: without ids it is the cell index, otherwise the microstructure index - 1
+  bool written = writer.write(totalPoints, sizeof(int32_t), [ids](char* buffer, size_t start, size_t end) {
+    int32_t* material = reinterpret_cast<int32_t*>(buffer);
+    for(size_t i = start; i < end; i++)
+    {
+      material[i - start] = (nullptr == ids) ? static_cast<int32_t>(i) : ids[i] - 1;
+    }
+  });
+  if(!written)
+  {
+    return false;
+  }
+
+  fprintf(f, "\n  </AppendedData>\n");
+  fprintf(f, "</VTKFile>\n");
+  return ferror(f) == 0;
+}
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cstdio>
+#include <string>
+#include <vector>
+
 #include <QtCore/QString>
 
 #include "SIMPLib/Common/Constants.h"
@@ -31,11 +35,13 @@ class SimulationIO_EXPORT ExportDAMASKFiles : public AbstractFilter
   PYB11_PROPERTY(int DataFormat READ getDataFormat WRITE setDataFormat)
   PYB11_PROPERTY(QString OutputPath READ getOutputPath WRITE setOutputPath)
   PYB11_PROPERTY(QString GeometryFileName READ getGeometryFileName WRITE setGeometryFileName)
+  PYB11_PROPERTY(int GeometryFileFormat READ getGeometryFileFormat WRITE setGeometryFileFormat)
   PYB11_PROPERTY(int HomogenizationIndex READ getHomogenizationIndex WRITE setHomogenizationIndex)
   PYB11_PROPERTY(DataArrayPath FeatureIdsArrayPath READ getFeatureIdsArrayPath WRITE setFeatureIdsArrayPath)
   PYB11_PROPERTY(DataArrayPath CellPhasesArrayPath READ getCellPhasesArrayPath WRITE setCellPhasesArrayPath)
   PYB11_PROPERTY(DataArrayPath CellEulerAnglesArrayPath READ getCellEulerAnglesArrayPath WRITE setCellEulerAnglesArrayPath)
   PYB11_PROPERTY(bool CompressGeomFile READ getCompressGeomFile WRITE setCompressGeomFile)
+  PYB11_PROPERTY(bool MergeIdenticalOrientations READ getMergeIdenticalOrientations WRITE setMergeIdenticalOrientations)
 
 public:
   SIMPL_SHARED_POINTERS(ExportDAMASKFiles)
@@ -53,6 +59,9 @@ public:
   SIMPL_FILTER_PARAMETER(QString, GeometryFileName)
   Q_PROPERTY(QString GeometryFileName READ getGeometryFileName WRITE setGeometryFileName)
 
+  SIMPL_FILTER_PARAMETER(int, GeometryFileFormat)
+  Q_PROPERTY(int GeometryFileFormat READ getGeometryFileFormat WRITE setGeometryFileFormat)
+
   SIMPL_FILTER_PARAMETER(int, HomogenizationIndex)
   Q_PROPERTY(int HomogenizationIndex READ getHomogenizationIndex WRITE setHomogenizationIndex)
 
@@ -68,6 +77,9 @@ public:
   SIMPL_FILTER_PARAMETER(bool, CompressGeomFile)
   Q_PROPERTY(bool CompressGeomFile READ getCompressGeomFile WRITE setCompressGeomFile)
 
+  SIMPL_FILTER_PARAMETER(bool, MergeIdenticalOrientations)
+  Q_PROPERTY(bool MergeIdenticalOrientations READ getMergeIdenticalOrientations WRITE setMergeIdenticalOrientations)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -175,6 +187,48 @@ private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, CellPhases)
   DEFINE_DATAARRAY_VARIABLE(float, CellEulerAngles)
 
+  /**
+   * @brief findUniqueOrientations Assigns one shared, one based microstructure index to all cells with the same
+   * phase and the same Euler angles (in degrees, quantized to 0.001). Indices are numbered in the order of
+   * first occurrence.
+   * @param totalPoints Number of cells
+   * @param cellIds Microstructure index of every cell
+   * @param phases Phase of every unique entry
+   * @param eulerAngles Quantized Euler angles of every unique entry, in thousandths of a degree
+   */
+  void findUniqueOrientations(size_t totalPoints, std::vector<int32_t>& cellIds, std::vector<int32_t>& phases, std::vector<int32_t>& eulerAngles);
+
+  /**
+   * @brief writeGeomMicrostructures Writes the microstructure index list of the geom file, honoring the
+   * compression option
+   * @param f Open geom file
+   * @param ids One based microstructure index of every cell, or nullptr if every cell is its own microstructure
+   * @param totalPoints Number of cells
+   * @param chunkSize Number of cells formatted per task
+   * @return false if the file could not be written
+   */
+  bool writeGeomMicrostructures(FILE* f, const int32_t* ids, size_t totalPoints, size_t chunkSize);
+
+  /**
+   * @brief AppendCompressedMicrostructures Appends the microstructure indices [start, end) to buffer using the DAMASK
+   * "n of x" and "a to b" shorthands for constant runs and ascending ranges of at least 3 cells. Other
+   * entries are written 10 per line. Every line of the output, including the last, ends with a new line.
+   */
+  static void AppendCompressedMicrostructures(std::string& buffer, const int32_t* ids, size_t start, size_t end);
+
+  /**
+   * @brief writeVtrGeometry Writes the grid as a VTK rectilinear grid (.vtr) with the zero based material index
+   * of every cell stored as a binary, optionally zlib compressed, cell array named "material"
+   * @param f Open .vtr file
+   * @param dims
+   * @param spacing
+   * @param origin
+   * @param ids One based microstructure index of every cell, or nullptr if every cell is its own microstructure
+   * @param totalPoints Number of cells
+   * @return false if the file could not be written
+   */
+  bool writeVtrGeometry(FILE* f, const SizeVec3Type& dims, const FloatVec3Type& spacing, const FloatVec3Type& origin, const int32_t* ids, size_t totalPoints);
+
 public:
   /* Rule of 5: All special member functions should be defined if any are defined.
    * https://github.com/isocpp/CppCoreGuidelines/blob/master/CppCoreGuidelines.md#c21-if-you-define-or-delete-any-default-operation-define-or-delete-them-all
@@ -35,10 +35,22 @@
 
 #include "ExportLAMMPSFile.h"
 
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
 
 #include "SIMPLib/FilterParameters/AbstractFilterParametersReader.h"
+#include "SIMPLib/FilterParameters/ChoiceFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataArraySelectionFilterParameter.h"
 #include "SIMPLib/FilterParameters/DataContainerSelectionFilterParameter.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
+#include "SIMPLib/FilterParameters/LinkedBooleanFilterParameter.h"
 #include "SIMPLib/FilterParameters/OutputFileFilterParameter.h"
 #include "SIMPLib/FilterParameters/SeparatorFilterParameter.h"
 #include "SIMPLib/FilterParameters/StringFilterParameter.h"
@@ -48,15 +60,313 @@
 #include "SIMPLib/Utilities/SIMPLibEndian.h"
 
 #include "SimulationIO/SimulationIOConstants.h"
+#include "SimulationIO/SimulationIOFilters/util/ChunkedTextWriter.hpp"
+#include "SimulationIO/SimulationIOFilters/util/TextFormatting.hpp"
 #include "SimulationIO/SimulationIOVersion.h"
 
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
+#include <tbb/partitioner.h>
+#endif
+
+/**
+ * @brief The FindAtomBoundsImpl class finds the bounding box of the atoms and the largest atom feature label
+ * in one pass over the interleaved vertex buffer and the label array
+ */
+class FindAtomBoundsImpl
+{
+public:
+  FindAtomBoundsImpl(const float* coords, const int32_t* labels)
+  : m_Coords(coords)
+  , m_Labels(labels)
+  {
+    initialize();
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  FindAtomBoundsImpl(const FindAtomBoundsImpl& other, tbb::split)
+  : m_Coords(other.m_Coords)
+  , m_Labels(other.m_Labels)
+  {
+    initialize();
+  }
+#endif
+
+  void convert(size_t start, size_t end)
+  {
+    // Local accumulators keep the loop free of aliasing so the compiler can vectorize it
+    float xMin = m_Min[0], yMin = m_Min[1], zMin = m_Min[2];
+    float xMax = m_Max[0], yMax = m_Max[1], zMax = m_Max[2];
+    int32_t maxLabel = m_MaxLabel;
+    for(size_t i = start; i < end; i++)
+    {
+      const float* pos = m_Coords + i * 3;
+      xMin = std::min(xMin, pos[0]);
+      xMax = std::max(xMax, pos[0]);
+      yMin = std::min(yMin, pos[1]);
+      yMax = std::max(yMax, pos[1]);
+      zMin = std::min(zMin, pos[2]);
+      zMax = std::max(zMax, pos[2]);
+      maxLabel = std::max(maxLabel, m_Labels[i]);
+    }
+    m_Min[0] = xMin;
+    m_Min[1] = yMin;
+    m_Min[2] = zMin;
+    m_Max[0] = xMax;
+    m_Max[1] = yMax;
+    m_Max[2] = zMax;
+    m_MaxLabel = maxLabel;
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r)
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+  void join(const FindAtomBoundsImpl& other)
+  {
+    for(size_t c = 0; c < 3; c++)
+    {
+      m_Min[c] = std::min(m_Min[c], other.m_Min[c]);
+      m_Max[c] = std::max(m_Max[c], other.m_Max[c]);
+    }
+    m_MaxLabel = std::max(m_MaxLabel, other.m_MaxLabel);
+  }
+
+  const float* getMin() const
+  {
+    return m_Min;
+  }
+
+  const float* getMax() const
+  {
+    return m_Max;
+  }
+
+  int32_t getMaxLabel() const
+  {
+    return m_MaxLabel;
+  }
+
+private:
+  const float* m_Coords;
+  const int32_t* m_Labels;
+  float m_Min[3];
+  float m_Max[3];
+  int32_t m_MaxLabel;
+
+  void initialize()
+  {
+    for(size_t c = 0; c < 3; c++)
+    {
+      m_Min[c] = std::numeric_limits<float>::max();
+      m_Max[c] = std::numeric_limits<float>::lowest();
+    }
+    m_MaxLabel = 0;
+  }
+};
+
+/**
+ * @brief The ConvertAtomsToDumpImpl class fills the rows of a binary dump chunk. The columns are
+ * "id type", then "mol" and "q" if those arrays are given, then "x y z", then "vx vy vz" if velocities are given.
+ */
+class ConvertAtomsToDumpImpl
+{
+public:
+  ConvertAtomsToDumpImpl(const float* coords, const int32_t* labels, const int32_t* moleculeIds, const float* charges, const float* velocities, const size_t* atomIndices, double* rows,
+                         size_t rowSize, size_t firstAtom)
+  : m_Coords(coords)
+  , m_Labels(labels)
+  , m_MoleculeIds(moleculeIds)
+  , m_Charges(charges)
+  , m_Velocities(velocities)
+  , m_AtomIndices(atomIndices)
+  , m_Rows(rows)
+  , m_RowSize(rowSize)
+  , m_FirstAtom(firstAtom)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t n = start; n < end; n++)
+    {
+      size_t i = (nullptr == m_AtomIndices) ? n : m_AtomIndices[n];
+      double* row = m_Rows + (n - m_FirstAtom) * m_RowSize;
+      *row++ = static_cast<double>(i + 1);
+      *row++ = static_cast<double>(m_Labels[i]);
+      if(nullptr != m_MoleculeIds)
+      {
+        *row++ = static_cast<double>(m_MoleculeIds[i]);
+      }
+      if(nullptr != m_Charges)
+      {
+        *row++ = static_cast<double>(m_Charges[i]);
+      }
+      *row++ = static_cast<double>(m_Coords[i * 3]);
+      *row++ = static_cast<double>(m_Coords[i * 3 + 1]);
+      *row++ = static_cast<double>(m_Coords[i * 3 + 2]);
+      if(nullptr != m_Velocities)
+      {
+        *row++ = static_cast<double>(m_Velocities[i * 3]);
+        *row++ = static_cast<double>(m_Velocities[i * 3 + 1]);
+        *row++ = static_cast<double>(m_Velocities[i * 3 + 2]);
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Coords;
+  const int32_t* m_Labels;
+  const int32_t* m_MoleculeIds;
+  const float* m_Charges;
+  const float* m_Velocities;
+  const size_t* m_AtomIndices;
+  double* m_Rows;
+  size_t m_RowSize;
+  size_t m_FirstAtom;
+};
+
+/**
+ * @brief The CountAtomBinsImpl class assigns every atom to a subdomain of a uniform processor grid and counts
+ * the atoms of each subdomain per block of atoms (first pass of the counting sort)
+ */
+class CountAtomBinsImpl
+{
+public:
+  CountAtomBinsImpl(const float* coords, size_t numAtoms, const float* boxMin, const float* boxMax, const int32_t* grid, size_t blockSize, int32_t* bins, size_t* counts)
+  : m_Coords(coords)
+  , m_NumAtoms(numAtoms)
+  , m_BoxMin(boxMin)
+  , m_Grid(grid)
+  , m_BlockSize(blockSize)
+  , m_Bins(bins)
+  , m_Counts(counts)
+  {
+    for(size_t c = 0; c < 3; c++)
+    {
+      m_InvWidth[c] = (boxMax[c] > boxMin[c]) ? static_cast<float>(grid[c]) / (boxMax[c] - boxMin[c]) : 0.0f;
+    }
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    size_t numBins = static_cast<size_t>(m_Grid[0]) * m_Grid[1] * m_Grid[2];
+    for(size_t block = start; block < end; block++)
+    {
+      size_t* counts = m_Counts + block * numBins;
+      size_t last = std::min((block + 1) * m_BlockSize, m_NumAtoms);
+      for(size_t i = block * m_BlockSize; i < last; i++)
+      {
+        int32_t ijk[3] = {0, 0, 0};
+        for(size_t c = 0; c < 3; c++)
+        {
+          int32_t k = static_cast<int32_t>((m_Coords[i * 3 + c] - m_BoxMin[c]) * m_InvWidth[c]);
+          ijk[c] = std::min(std::max(k, 0), m_Grid[c] - 1);
+        }
+        // Same numbering as the default LAMMPS processor map (map cart, built with MPI_Cart_create): z varies fastest
+        int32_t bin = ijk[2] + m_Grid[2] * (ijk[1] + m_Grid[1] * ijk[0]);
+        m_Bins[i] = bin;
+        counts[bin]++;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const float* m_Coords;
+  size_t m_NumAtoms;
+  const float* m_BoxMin;
+  const int32_t* m_Grid;
+  size_t m_BlockSize;
+  int32_t* m_Bins;
+  size_t* m_Counts;
+  float m_InvWidth[3];
+};
+
+/**
+ * @brief The ScatterAtomBinsImpl class writes the atom indices of every block to their sorted positions
+ * (second pass of the counting sort). The order of the atoms inside a subdomain is the input order.
+ */
+class ScatterAtomBinsImpl
+{
+public:
+  ScatterAtomBinsImpl(const int32_t* bins, size_t numAtoms, size_t numBins, size_t blockSize, const size_t* offsets, size_t* order)
+  : m_Bins(bins)
+  , m_NumAtoms(numAtoms)
+  , m_NumBins(numBins)
+  , m_BlockSize(blockSize)
+  , m_Offsets(offsets)
+  , m_Order(order)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    std::vector<size_t> positions(m_NumBins);
+    for(size_t block = start; block < end; block++)
+    {
+      std::copy(m_Offsets + block * m_NumBins, m_Offsets + (block + 1) * m_NumBins, positions.begin());
+      size_t last = std::min((block + 1) * m_BlockSize, m_NumAtoms);
+      for(size_t i = block * m_BlockSize; i < last; i++)
+      {
+        m_Order[positions[m_Bins[i]]++] = i;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  const int32_t* m_Bins;
+  size_t m_NumAtoms;
+  size_t m_NumBins;
+  size_t m_BlockSize;
+  const size_t* m_Offsets;
+  size_t* m_Order;
+};
+
 // -----------------------------------------------------------------------------
 //
 // -----------------------------------------------------------------------------
 ExportLAMMPSFile::ExportLAMMPSFile()
 : m_LammpsFile("")
+, m_OutputFormat(0)
+, m_SplitIntoSubdomains(false)
 , m_AtomFeatureLabelsPath(SIMPL::Defaults::VertexDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::AtomFeatureLabels)
+, m_AtomStyle(0)
+, m_ChargesArrayPath(SIMPL::Defaults::VertexDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, "Charges")
+, m_MoleculeIdsArrayPath(SIMPL::Defaults::VertexDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, SIMPL::VertexData::AtomFeatureLabels)
+, m_WriteVelocities(false)
+, m_VelocitiesArrayPath(SIMPL::Defaults::VertexDataContainerName, SIMPL::Defaults::VertexAttributeMatrixName, "Velocities")
+, m_WriteMasses(false)
+, m_MassesArrayPath("", "", "")
 {
+  m_ProcessorGrid[0] = 2;
+  m_ProcessorGrid[1] = 2;
+  m_ProcessorGrid[2] = 2;
 }
 
 // -----------------------------------------------------------------------------
@@ -72,11 +382,69 @@ void ExportLAMMPSFile::setupFilterParameters()
   FilterParameterVectorType parameters;
 
   parameters.push_back(SIMPL_NEW_OUTPUT_FILE_FP("LAMMPS File", LammpsFile, FilterParameter::Parameter, ExportLAMMPSFile));
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Output Format");
+    parameter->setPropertyName("OutputFormat");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(ExportLAMMPSFile, this, OutputFormat));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(ExportLAMMPSFile, this, OutputFormat));
+
+    QVector<QString> choices;
+    choices.push_back("Data File (read_data)");
+    choices.push_back("Binary Dump (read_dump/rerun)");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
+  {
+    QStringList linkedProps = {"ProcessorGrid"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Split Into Subdomains", SplitIntoSubdomains, FilterParameter::Parameter, ExportLAMMPSFile, linkedProps));
+    parameters.push_back(SIMPL_NEW_INT_VEC3_FP("Processor Grid", ProcessorGrid, FilterParameter::Parameter, ExportLAMMPSFile));
+  }
+
+  {
+    ChoiceFilterParameter::Pointer parameter = ChoiceFilterParameter::New();
+    parameter->setHumanLabel("Atom Style");
+    parameter->setPropertyName("AtomStyle");
+    parameter->setSetterCallback(SIMPL_BIND_SETTER(ExportLAMMPSFile, this, AtomStyle));
+    parameter->setGetterCallback(SIMPL_BIND_GETTER(ExportLAMMPSFile, this, AtomStyle));
+
+    QVector<QString> choices;
+    choices.push_back("atomic");
+    choices.push_back("charge");
+    choices.push_back("molecular");
+    choices.push_back("full");
+    parameter->setChoices(choices);
+    parameter->setCategory(FilterParameter::Parameter);
+    parameters.push_back(parameter);
+  }
+  {
+    QStringList linkedProps = {"VelocitiesArrayPath"};
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Write Velocities", WriteVelocities, FilterParameter::Parameter, ExportLAMMPSFile, linkedProps));
+    linkedProps = QStringList({"MassesArrayPath"});
+    parameters.push_back(SIMPL_NEW_LINKED_BOOL_FP("Write Masses", WriteMasses, FilterParameter::Parameter, ExportLAMMPSFile, linkedProps));
+  }
 
   {
     DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Vertex, IGeometry::Type::Vertex);
     parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Atom Feature Labels", AtomFeatureLabelsPath, FilterParameter::RequiredArray, ExportLAMMPSFile, req));
   }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 1, AttributeMatrix::Type::Vertex, IGeometry::Type::Vertex);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Charges (charge, full)", ChargesArrayPath, FilterParameter::RequiredArray, ExportLAMMPSFile, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Int32, 1, AttributeMatrix::Type::Vertex, IGeometry::Type::Vertex);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Molecule Ids (molecular, full)", MoleculeIdsArrayPath, FilterParameter::RequiredArray, ExportLAMMPSFile, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 3, AttributeMatrix::Type::Vertex, IGeometry::Type::Vertex);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Velocities", VelocitiesArrayPath, FilterParameter::RequiredArray, ExportLAMMPSFile, req));
+  }
+  {
+    DataArraySelectionFilterParameter::RequirementType req = DataArraySelectionFilterParameter::CreateRequirement(SIMPL::TypeNames::Float, 1, AttributeMatrix::Type::Any, IGeometry::Type::Any);
+    parameters.push_back(SIMPL_NEW_DA_SELECTION_FP("Masses (one per atom type)", MassesArrayPath, FilterParameter::RequiredArray, ExportLAMMPSFile, req));
+  }
 
   setFilterParameters(parameters);
 }
@@ -88,7 +456,17 @@ void ExportLAMMPSFile::readFilterParameters(AbstractFilterParametersReader* read
 {
   reader->openFilterGroup(this, index);
   setLammpsFile(reader->readString("LammpsFile", getLammpsFile()));
+  setOutputFormat(reader->readValue("OutputFormat", getOutputFormat()));
+  setSplitIntoSubdomains(reader->readValue("SplitIntoSubdomains", getSplitIntoSubdomains()));
+  setProcessorGrid(reader->readIntVec3("ProcessorGrid", getProcessorGrid()));
   setAtomFeatureLabelsPath(reader->readDataArrayPath("AtomFeatureLabelsPath", getAtomFeatureLabelsPath()));
+  setAtomStyle(reader->readValue("AtomStyle", getAtomStyle()));
+  setChargesArrayPath(reader->readDataArrayPath("ChargesArrayPath", getChargesArrayPath()));
+  setMoleculeIdsArrayPath(reader->readDataArrayPath("MoleculeIdsArrayPath", getMoleculeIdsArrayPath()));
+  setWriteVelocities(reader->readValue("WriteVelocities", getWriteVelocities()));
+  setVelocitiesArrayPath(reader->readDataArrayPath("VelocitiesArrayPath", getVelocitiesArrayPath()));
+  setWriteMasses(reader->readValue("WriteMasses", getWriteMasses()));
+  setMassesArrayPath(reader->readDataArrayPath("MassesArrayPath", getMassesArrayPath()));
   reader->closeFilterGroup();
 }
 
@@ -109,6 +487,19 @@ void ExportLAMMPSFile::dataCheck()
 
   FileSystemPathHelper::CheckOutputFile(this, "Output LAMMPS File", getLammpsFile(), true);
 
+  // The LAMMPS native dump reader only treats a file as binary if its name ends in ".bin"
+  if(getOutputFormat() == 1 && !getLammpsFile().endsWith(".bin"))
+  {
+    QString ss = QObject::tr("LAMMPS only reads binary dump files whose name ends in '.bin': '%1'").arg(getLammpsFile());
+    setWarningCondition(-38402, ss);
+  }
+
+  if(getSplitIntoSubdomains() && (m_ProcessorGrid[0] < 1 || m_ProcessorGrid[1] < 1 || m_ProcessorGrid[2] < 1))
+  {
+    QString ss = QObject::tr("The processor grid must have at least one subdomain in every direction");
+    setErrorCondition(-38403, ss);
+  }
+
   getDataContainerArray()->getPrereqGeometryFromDataContainer<VertexGeom, AbstractFilter>(this, getAtomFeatureLabelsPath().getDataContainerName());
 
   DataContainer::Pointer v = getDataContainerArray()->getDataContainer(getAtomFeatureLabelsPath().getDataContainerName());
@@ -144,6 +535,69 @@ void ExportLAMMPSFile::dataCheck()
     dataArrayPaths.push_back(getAtomFeatureLabelsPath());
   }
 
+  // The optional arrays stay nullptr when the atom style or the options do not use them
+  m_Charges = nullptr;
+  m_MoleculeIds = nullptr;
+  m_Velocities = nullptr;
+  m_Masses = nullptr;
+
+  if(getAtomStyle() == 1 || getAtomStyle() == 3)
+  {
+    m_ChargesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getChargesArrayPath(), cDims);
+    if(nullptr != m_ChargesPtr.lock())
+    {
+      m_Charges = m_ChargesPtr.lock()->getPointer(0);
+    }
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getChargesArrayPath());
+    }
+  }
+
+  if(getAtomStyle() == 2 || getAtomStyle() == 3)
+  {
+    m_MoleculeIdsPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<int32_t>, AbstractFilter>(this, getMoleculeIdsArrayPath(), cDims);
+    if(nullptr != m_MoleculeIdsPtr.lock())
+    {
+      m_MoleculeIds = m_MoleculeIdsPtr.lock()->getPointer(0);
+    }
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getMoleculeIdsArrayPath());
+    }
+  }
+
+  if(getWriteMasses())
+  {
+    if(getOutputFormat() == 1)
+    {
+      QString ss = QObject::tr("Binary dump files have no Masses section; the masses are not written");
+      setWarningCondition(-38404, ss);
+    }
+    else
+    {
+      m_MassesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getMassesArrayPath(), cDims);
+      if(nullptr != m_MassesPtr.lock())
+      {
+        m_Masses = m_MassesPtr.lock()->getPointer(0);
+      }
+    }
+  }
+
+  if(getWriteVelocities())
+  {
+    cDims[0] = 3;
+    m_VelocitiesPtr = getDataContainerArray()->getPrereqArrayFromPath<DataArray<float>, AbstractFilter>(this, getVelocitiesArrayPath(), cDims);
+    if(nullptr != m_VelocitiesPtr.lock())
+    {
+      m_Velocities = m_VelocitiesPtr.lock()->getPointer(0);
+    }
+    if(getErrorCode() >= 0)
+    {
+      dataArrayPaths.push_back(getVelocitiesArrayPath());
+    }
+  }
+
   getDataContainerArray()->validateNumberOfTuples<AbstractFilter>(this, dataArrayPaths);
 }
 
@@ -175,91 +629,373 @@ void ExportLAMMPSFile::execute()
   VertexGeom::Pointer vertices = v->getGeometryAs<VertexGeom>();
   int64_t numAtoms = vertices->getNumberOfVertices();
 
-  // find total number of Atom Types
-  int32_t numAtomTypes = 0;
-  for(int32_t i = 0; i < numAtoms; i++) // find number of grainIds
+  // Bounding box and number of atom types, found in one pass
+  float* coords = vertices->getVertexPointer(0);
+  int32_t* labels = m_AtomFeatureLabels;
+  FindAtomBoundsImpl bounds(coords, labels);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_reduce(tbb::blocked_range<size_t>(0, static_cast<size_t>(numAtoms), 65536), bounds);
+#else
+  bounds.convert(0, static_cast<size_t>(numAtoms));
+#endif
+  int32_t numAtomTypes = bounds.getMaxLabel();
+
+  // Masses are indexed by atom type, index 0 is not used
+  if(nullptr != m_Masses && m_MassesPtr.lock()->getNumberOfTuples() <= static_cast<size_t>(numAtomTypes))
   {
-    if(m_AtomFeatureLabels[i] > numAtomTypes)
+    QString ss = QObject::tr("The masses array needs %1 tuples (one per atom type plus the unused index 0) but has %2").arg(numAtomTypes + 1).arg(m_MassesPtr.lock()->getNumberOfTuples());
+    setErrorCondition(-11002, ss);
+    return;
+  }
+  float boxMin[3] = {0.0f, 0.0f, 0.0f};
+  float boxMax[3] = {0.0f, 0.0f, 0.0f};
+  if(numAtoms > 0)
+  {
+    std::copy(bounds.getMin(), bounds.getMin() + 3, boxMin);
+    std::copy(bounds.getMax(), bounds.getMax() + 3, boxMax);
+  }
+
+  if(m_SplitIntoSubdomains)
+  {
+    writeSubdomainFiles(coords, labels, static_cast<size_t>(numAtoms), numAtomTypes, boxMin, boxMax);
+    if(getErrorCode() < 0)
+    {
+      return;
+    }
+  }
+  else
+  {
+    FILE* lammpsFile = nullptr;
+    lammpsFile = fopen(m_LammpsFile.toLatin1().data(), "wb");
+    if(nullptr == lammpsFile)
     {
-      numAtomTypes = m_AtomFeatureLabels[i];
+      QString ss = QObject::tr(": Error creating LAMMPS output file '%1'").arg(getLammpsFile());
+      setErrorCondition(-11000, ss);
+      return;
     }
+
+    if(!writeAtoms(lammpsFile, coords, labels, nullptr, static_cast<size_t>(numAtoms), numAtomTypes, boxMin, boxMax))
+    {
+      fclose(lammpsFile);
+      QString ss = QObject::tr("Error writing LAMMPS output file '%1'").arg(getLammpsFile());
+      setErrorCondition(-11001, ss);
+      return;
+    }
+
+    // Close the input and output files
+    fclose(lammpsFile);
   }
 
-  FILE* lammpsFile = nullptr;
-  lammpsFile = fopen(m_LammpsFile.toLatin1().data(), "wb");
-  if(nullptr == lammpsFile)
+  clearErrorCode();
+  clearWarningCode();
+  notifyStatusMessage("Complete");
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExportLAMMPSFile::writeAtoms(FILE* f, const float* coords, const int32_t* labels, const size_t* atomIndices, size_t numAtoms, int32_t numAtomTypes, const float* boxMin, const float* boxMax)
+{
+  if(m_OutputFormat == 1)
   {
-    QString ss = QObject::tr(": Error creating LAMMPS output file '%1'").arg(getLammpsFile());
-    setErrorCondition(-11000, ss);
-    return;
+    return writeBinaryDump(f, coords, labels, atomIndices, numAtoms, boxMin, boxMax);
   }
+  return writeDataFile(f, coords, labels, atomIndices, numAtoms, numAtomTypes, boxMin, boxMax);
+}
 
-  float xMin = 1000000000.0;
-  float xMax = 0.0;
-  float yMin = 1000000000.0;
-  float yMax = 0.0;
-  float zMin = 1000000000.0;
-  float zMax = 0.0;
-  int dummy = 0;
-  float pos[3] = {0.0f, 0.0f, 0.0f};
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExportLAMMPSFile::getSubdomainFileName(int32_t rank) const
+{
+  // "name.%.ext" follows the LAMMPS multi file convention, otherwise the rank is inserted before the extension
+  QString rankString = QString::number(rank);
+  if(m_LammpsFile.contains('%'))
+  {
+    QString fileName = m_LammpsFile;
+    return fileName.replace('%', rankString);
+  }
+  QFileInfo fi(m_LammpsFile);
+  QString suffix = fi.completeSuffix();
+  QString baseName = fi.path() + QDir::separator() + fi.baseName();
+  return suffix.isEmpty() ? baseName + "." + rankString : baseName + "." + rankString + "." + suffix;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExportLAMMPSFile::writeSubdomainFiles(const float* coords, const int32_t* labels, size_t numAtoms, int32_t numAtomTypes, const float* boxMin, const float* boxMax)
+{
+  const int32_t grid[3] = {m_ProcessorGrid[0], m_ProcessorGrid[1], m_ProcessorGrid[2]};
+  size_t numBins = static_cast<size_t>(grid[0]) * grid[1] * grid[2];
+
+  // Counting sort of the atoms by subdomain: count per block, turn the counts into start offsets, then scatter
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  size_t numThreads = std::max<size_t>(std::thread::hardware_concurrency(), 1);
+  size_t blockSize = std::max<size_t>((numAtoms + 4 * numThreads - 1) / (4 * numThreads), 65536);
+#else
+  size_t blockSize = std::max<size_t>(numAtoms, 1);
+#endif
+  size_t numBlocks = (numAtoms + blockSize - 1) / blockSize;
 
-  for(int64_t i = 0; i < numAtoms; i++)
+  std::vector<int32_t> bins(numAtoms);
+  std::vector<size_t> offsets(numBlocks * numBins, 0);
+  CountAtomBinsImpl countImpl(coords, numAtoms, boxMin, boxMax, grid, blockSize, bins.data(), offsets.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), countImpl);
+#else
+  countImpl.convert(0, numBlocks);
+#endif
+
+  std::vector<size_t> binStart(numBins + 1, 0);
+  size_t position = 0;
+  for(size_t bin = 0; bin < numBins; bin++)
   {
-    vertices->getCoords(i, pos);
-    if(pos[0] < xMin)
+    binStart[bin] = position;
+    for(size_t block = 0; block < numBlocks; block++)
     {
-      xMin = pos[0];
+      size_t count = offsets[block * numBins + bin];
+      offsets[block * numBins + bin] = position;
+      position += count;
     }
-    if(pos[0] > xMax)
+  }
+  binStart[numBins] = position;
+
+  std::vector<size_t> order(numAtoms);
+  ScatterAtomBinsImpl scatterImpl(bins.data(), numAtoms, numBins, blockSize, offsets.data(), order.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBlocks, 1), scatterImpl);
+#else
+  scatterImpl.convert(0, numBlocks);
+#endif
+  bins.clear();
+  bins.shrink_to_fit();
+
+  // One file per subdomain, written concurrently. Every file has the global box, the global number of atom
+  // types and the global atom ids, so the files can be read independently
+  std::vector<int32_t> status(numBins, 0);
+  auto writeRange = [&](size_t start, size_t end) {
+    for(size_t bin = start; bin < end; bin++)
     {
-      xMax = pos[0];
+      QString fileName = getSubdomainFileName(static_cast<int32_t>(bin));
+      FILE* f = fopen(fileName.toLatin1().data(), "wb");
+      if(nullptr == f)
+      {
+        status[bin] = -11000;
+        continue;
+      }
+      if(!writeAtoms(f, coords, labels, order.data() + binStart[bin], binStart[bin + 1] - binStart[bin], numAtomTypes, boxMin, boxMax))
+      {
+        status[bin] = -11001;
+      }
+      fclose(f);
     }
-    if(pos[1] < yMin)
+  };
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, numBins, 1), [&](const tbb::blocked_range<size_t>& r) { writeRange(r.begin(), r.end()); }, tbb::simple_partitioner());
+#else
+  writeRange(0, numBins);
+#endif
+
+  for(size_t bin = 0; bin < numBins; bin++)
+  {
+    if(status[bin] < 0)
     {
-      yMin = pos[1];
+      QString ss = QObject::tr("Error writing LAMMPS output file '%1'").arg(getSubdomainFileName(static_cast<int32_t>(bin)));
+      setErrorCondition(status[bin], ss);
+      return;
     }
-    if(pos[1] > yMax)
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExportLAMMPSFile::writeDataFile(FILE* f, const float* coords, const int32_t* labels, const size_t* atomIndices, size_t numAtoms, int32_t numAtomTypes, const float* boxMin, const float* boxMax)
+{
+  static const char* k_AtomStyleNames[] = {"atomic", "charge", "molecular", "full"};
+
+  fprintf(f, "LAMMPS data file\n");
+  fprintf(f, "\n");
+  fprintf(f, "%lld atoms\n", (long long int)(numAtoms));
+  fprintf(f, "\n");
+  fprintf(f, "%lld atom types\n", (long long int)(numAtomTypes));
+  fprintf(f, "\n");
+  fprintf(f, "%f %f xlo xhi\n", boxMin[0], boxMax[0]);
+  fprintf(f, "%f %f ylo yhi\n", boxMin[1], boxMax[1]);
+  fprintf(f, "%f %f zlo zhi\n", boxMin[2], boxMax[2]);
+  fprintf(f, "\n");
+  if(nullptr != m_Masses)
+  {
+    fprintf(f, "Masses\n");
+    fprintf(f, "\n");
+    for(int32_t type = 1; type <= numAtomTypes; type++)
     {
-      yMax = pos[1];
+      fprintf(f, "%d %.9g\n", type, m_Masses[type]);
     }
-    if(pos[2] < zMin)
+    fprintf(f, "\n");
+  }
+  if(m_AtomStyle > 0 && m_AtomStyle < 4)
+  {
+    fprintf(f, "Atoms # %s\n", k_AtomStyleNames[m_AtomStyle]);
+  }
+  else
+  {
+    fprintf(f, "Atoms\n");
+  }
+  fprintf(f, "\n");
+
+  // Write the Atom positions (Vertices). The lines are formatted in parallel chunks and written in order.
+  // For the atomic style the text is the same as "%lld %d %f %f %f %d %d %d\n" with zero image flags;
+  // the other styles add the molecule id before and/or the charge after the atom type
+  const int32_t* moleculeIds = m_MoleculeIds;
+  const float* charges = m_Charges;
+  SimulationIO::ChunkedTextWriter atomsWriter(f);
+  atomsWriter.setChunkSize(65536);
+  bool written = atomsWriter.write(numAtoms, [coords, labels, moleculeIds, charges, atomIndices](std::string& buffer, size_t start, size_t end) {
+    const size_t k_MaxCharsPerLine = 3 * 21 + 4 * SimulationIO::TextFormatting::k_MaxCharsPerValue + 16;
+    buffer.resize((end - start) * k_MaxCharsPerLine);
+    char* out = &buffer[0];
+    char* p = out;
+    for(size_t n = start; n < end; n++)
     {
-      zMin = pos[2];
+      size_t i = (nullptr == atomIndices) ? n : atomIndices[n];
+      p = SimulationIO::TextFormatting::FormatInt(p, static_cast<int64_t>(i) + 1);
+      if(nullptr != moleculeIds)
+      {
+        *p++ = ' ';
+        p = SimulationIO::TextFormatting::FormatInt(p, moleculeIds[i]);
+      }
+      *p++ = ' ';
+      p = SimulationIO::TextFormatting::FormatInt(p, labels[i]);
+      if(nullptr != charges)
+      {
+        *p++ = ' ';
+        p = SimulationIO::TextFormatting::FormatRoundTrip(p, charges[i]);
+      }
+      for(size_t c = 0; c < 3; c++)
+      {
+        *p++ = ' ';
+        p = SimulationIO::TextFormatting::FormatFixed(p, coords[i * 3 + c], 6);
+      }
+      std::memcpy(p, " 0 0 0\n", 7);
+      p += 7;
     }
-    if(pos[2] > zMax)
+    buffer.resize(static_cast<size_t>(p - out));
+  });
+  if(!written)
+  {
+    return false;
+  }
+
+  if(nullptr != m_Velocities)
+  {
+    fprintf(f, "\n");
+    fprintf(f, "Velocities\n");
+    fprintf(f, "\n");
+    const float* velocities = m_Velocities;
+    written = atomsWriter.write(numAtoms, [velocities, atomIndices](std::string& buffer, size_t start, size_t end) {
+      const size_t k_MaxCharsPerLine = 21 + 3 * SimulationIO::TextFormatting::k_MaxCharsPerValue + 8;
+      buffer.resize((end - start) * k_MaxCharsPerLine);
+      char* out = &buffer[0];
+      char* p = out;
+      for(size_t n = start; n < end; n++)
+      {
+        size_t i = (nullptr == atomIndices) ? n : atomIndices[n];
+        p = SimulationIO::TextFormatting::FormatInt(p, static_cast<int64_t>(i) + 1);
+        for(size_t c = 0; c < 3; c++)
+        {
+          *p++ = ' ';
+          p = SimulationIO::TextFormatting::FormatRoundTrip(p, velocities[i * 3 + c]);
+        }
+        *p++ = '\n';
+      }
+      buffer.resize(static_cast<size_t>(p - out));
+    });
+    if(!written)
     {
-      zMax = pos[2];
+      return false;
     }
   }
 
-  fprintf(lammpsFile, "LAMMPS data file\n");
-  fprintf(lammpsFile, "\n");
-  fprintf(lammpsFile, "%lld atoms\n", (long long int)(numAtoms));
-  fprintf(lammpsFile, "\n");
-  fprintf(lammpsFile, "%lld atom types\n", (long long int)(numAtomTypes));
-  fprintf(lammpsFile, "\n");
-  fprintf(lammpsFile, "%f %f xlo xhi\n", xMin, xMax);
-  fprintf(lammpsFile, "%f %f ylo yhi\n", yMin, yMax);
-  fprintf(lammpsFile, "%f %f zlo zhi\n", zMin, zMax);
-  fprintf(lammpsFile, "\n");
-  fprintf(lammpsFile, "Atoms\n");
-  fprintf(lammpsFile, "\n");
+  fprintf(f, "\n");
+  return ferror(f) == 0;
+}
 
-  // Write the Atom positions (Vertices)
-  for(int64_t i = 0; i < numAtoms; i++)
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExportLAMMPSFile::writeBinaryDump(FILE* f, const float* coords, const int32_t* labels, const size_t* atomIndices, size_t numAtoms, const float* boxMin, const float* boxMax)
+{
+  // Same layout as the binary output of LAMMPS "dump atom" (or "dump custom" when there are more columns than
+  // "id type x y z"), format revision 2, so read_dump and rerun can read it back: a header followed by
+  // chunks of [int n, n doubles]
+  std::string columns = "id type";
+  if(nullptr != m_MoleculeIds)
+  {
+    columns += " mol";
+  }
+  if(nullptr != m_Charges)
   {
-    vertices->getCoords(i, pos);
-    fprintf(lammpsFile, "%lld %d %f %f %f %d %d %d\n", (long long int)(i + 1), m_AtomFeatureLabels[i], pos[0], pos[1], pos[2], dummy, dummy, dummy); // Write the positions to the output file
+    columns += " q";
   }
+  columns += " x y z";
+  if(nullptr != m_Velocities)
+  {
+    columns += " vx vy vz";
+  }
+  int32_t sizeOne = 5 + (nullptr != m_MoleculeIds ? 1 : 0) + (nullptr != m_Charges ? 1 : 0) + (nullptr != m_Velocities ? 3 : 0);
+  std::string magicString = (sizeOne == 5) ? "DUMPATOM" : "DUMPCUSTOM";
 
-  fprintf(lammpsFile, "\n");
+  int64_t magicLength = -static_cast<int64_t>(magicString.size());
+  int32_t endian = 0x0001;
+  int32_t revision = 0x0002;
+  int64_t timestep = 0;
+  int64_t natoms = static_cast<int64_t>(numAtoms);
+  int32_t triclinic = 0;
+  int32_t boundary[6] = {0, 0, 0, 0, 0, 0}; // periodic in all directions
+  double box[6] = {boxMin[0], boxMax[0], boxMin[1], boxMax[1], boxMin[2], boxMax[2]};
+  int32_t unitStyleLength = 0;
+  char timeFlag = 0;
+  int32_t columnsLength = static_cast<int32_t>(columns.size());
 
-  // Close the input and output files
-  fclose(lammpsFile);
+  // LAMMPS stores the chunk length as an int number of doubles
+  const size_t k_AtomsPerChunk = 1024 * 1024;
+  int32_t numChunks = static_cast<int32_t>((numAtoms + k_AtomsPerChunk - 1) / k_AtomsPerChunk);
 
-  clearErrorCode();
-  clearWarningCode();
-  notifyStatusMessage("Complete");
+  fwrite(&magicLength, sizeof(magicLength), 1, f);
+  fwrite(magicString.data(), 1, magicString.size(), f);
+  fwrite(&endian, sizeof(endian), 1, f);
+  fwrite(&revision, sizeof(revision), 1, f);
+  fwrite(&timestep, sizeof(timestep), 1, f);
+  fwrite(&natoms, sizeof(natoms), 1, f);
+  fwrite(&triclinic, sizeof(triclinic), 1, f);
+  fwrite(boundary, sizeof(int32_t), 6, f);
+  fwrite(box, sizeof(double), 6, f);
+  fwrite(&sizeOne, sizeof(sizeOne), 1, f);
+  fwrite(&unitStyleLength, sizeof(unitStyleLength), 1, f);
+  fwrite(&timeFlag, sizeof(timeFlag), 1, f);
+  fwrite(&columnsLength, sizeof(columnsLength), 1, f);
+  fwrite(columns.data(), 1, columns.size(), f);
+  fwrite(&numChunks, sizeof(numChunks), 1, f);
+
+  std::vector<double> buffer(std::min(numAtoms, k_AtomsPerChunk) * sizeOne);
+  for(size_t start = 0; start < numAtoms; start += k_AtomsPerChunk)
+  {
+    size_t end = std::min(start + k_AtomsPerChunk, numAtoms);
+    ConvertAtomsToDumpImpl impl(coords, labels, m_MoleculeIds, m_Charges, m_Velocities, atomIndices, buffer.data(), static_cast<size_t>(sizeOne), start);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    tbb::parallel_for(tbb::blocked_range<size_t>(start, end), impl);
+#else
+    impl.convert(start, end);
+#endif
+    int32_t n = static_cast<int32_t>((end - start) * sizeOne);
+    if(fwrite(&n, sizeof(n), 1, f) != 1 || fwrite(buffer.data(), sizeof(double), static_cast<size_t>(n), f) != static_cast<size_t>(n))
+    {
+      return false;
+    }
+  }
+  return ferror(f) == 0;
 }
 
 // -----------------------------------------------------------------------------
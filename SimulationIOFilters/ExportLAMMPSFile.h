@@ -35,12 +35,15 @@
 
 #pragma once
 
+#include <cstdio>
+
 #include <QtCore/QString>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
 #include "SIMPLib/DataArrays/IDataArray.h"
 #include "SIMPLib/DataContainers/DataContainer.h"
+#include "SIMPLib/FilterParameters/IntVec3FilterParameter.h"
 #include "SIMPLib/Filtering/AbstractFilter.h"
 #include "SIMPLib/SIMPLib.h"
 
@@ -54,6 +57,16 @@ class SimulationIO_EXPORT ExportLAMMPSFile : public AbstractFilter
   Q_OBJECT
   PYB11_CREATE_BINDINGS(ExportLAMMPSFile SUPERCLASS AbstractFilter)
   PYB11_PROPERTY(QString LammpsFile READ getLammpsFile WRITE setLammpsFile)
+  PYB11_PROPERTY(int OutputFormat READ getOutputFormat WRITE setOutputFormat)
+  PYB11_PROPERTY(bool SplitIntoSubdomains READ getSplitIntoSubdomains WRITE setSplitIntoSubdomains)
+  PYB11_PROPERTY(IntVec3Type ProcessorGrid READ getProcessorGrid WRITE setProcessorGrid)
+  PYB11_PROPERTY(int AtomStyle READ getAtomStyle WRITE setAtomStyle)
+  PYB11_PROPERTY(DataArrayPath ChargesArrayPath READ getChargesArrayPath WRITE setChargesArrayPath)
+  PYB11_PROPERTY(DataArrayPath MoleculeIdsArrayPath READ getMoleculeIdsArrayPath WRITE setMoleculeIdsArrayPath)
+  PYB11_PROPERTY(bool WriteVelocities READ getWriteVelocities WRITE setWriteVelocities)
+  PYB11_PROPERTY(DataArrayPath VelocitiesArrayPath READ getVelocitiesArrayPath WRITE setVelocitiesArrayPath)
+  PYB11_PROPERTY(bool WriteMasses READ getWriteMasses WRITE setWriteMasses)
+  PYB11_PROPERTY(DataArrayPath MassesArrayPath READ getMassesArrayPath WRITE setMassesArrayPath)
   PYB11_PROPERTY(DataArrayPath AtomFeatureLabelsPath READ getAtomFeatureLabelspath WRITE setAtomFeatureLabelsPath)
 public:
   SIMPL_SHARED_POINTERS(ExportLAMMPSFile)
@@ -65,9 +78,39 @@ public:
   SIMPL_FILTER_PARAMETER(QString, LammpsFile)
   Q_PROPERTY(QString LammpsFile READ getLammpsFile WRITE setLammpsFile)
 
+  SIMPL_FILTER_PARAMETER(int, OutputFormat)
+  Q_PROPERTY(int OutputFormat READ getOutputFormat WRITE setOutputFormat)
+
+  SIMPL_FILTER_PARAMETER(bool, SplitIntoSubdomains)
+  Q_PROPERTY(bool SplitIntoSubdomains READ getSplitIntoSubdomains WRITE setSplitIntoSubdomains)
+
+  SIMPL_FILTER_PARAMETER(IntVec3Type, ProcessorGrid)
+  Q_PROPERTY(IntVec3Type ProcessorGrid READ getProcessorGrid WRITE setProcessorGrid)
+
   SIMPL_FILTER_PARAMETER(DataArrayPath, AtomFeatureLabelsPath)
   Q_PROPERTY(DataArrayPath AtomFeatureLabelsPath READ getAtomFeatureLabelsPath WRITE setAtomFeatureLabelsPath)
 
+  SIMPL_FILTER_PARAMETER(int, AtomStyle)
+  Q_PROPERTY(int AtomStyle READ getAtomStyle WRITE setAtomStyle)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, ChargesArrayPath)
+  Q_PROPERTY(DataArrayPath ChargesArrayPath READ getChargesArrayPath WRITE setChargesArrayPath)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, MoleculeIdsArrayPath)
+  Q_PROPERTY(DataArrayPath MoleculeIdsArrayPath READ getMoleculeIdsArrayPath WRITE setMoleculeIdsArrayPath)
+
+  SIMPL_FILTER_PARAMETER(bool, WriteVelocities)
+  Q_PROPERTY(bool WriteVelocities READ getWriteVelocities WRITE setWriteVelocities)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, VelocitiesArrayPath)
+  Q_PROPERTY(DataArrayPath VelocitiesArrayPath READ getVelocitiesArrayPath WRITE setVelocitiesArrayPath)
+
+  SIMPL_FILTER_PARAMETER(bool, WriteMasses)
+  Q_PROPERTY(bool WriteMasses READ getWriteMasses WRITE setWriteMasses)
+
+  SIMPL_FILTER_PARAMETER(DataArrayPath, MassesArrayPath)
+  Q_PROPERTY(DataArrayPath MassesArrayPath READ getMassesArrayPath WRITE setMassesArrayPath)
+
   /**
    * @brief getCompiledLibraryName Reimplemented from @see AbstractFilter class
    */
@@ -171,6 +214,48 @@ protected:
 
 private:
   DEFINE_DATAARRAY_VARIABLE(int32_t, AtomFeatureLabels)
+  DEFINE_DATAARRAY_VARIABLE(float, Charges)
+  DEFINE_DATAARRAY_VARIABLE(int32_t, MoleculeIds)
+  DEFINE_DATAARRAY_VARIABLE(float, Velocities)
+  DEFINE_DATAARRAY_VARIABLE(float, Masses)
+
+  /**
+   * @brief writeSubdomainFiles Sorts the atoms into the subdomains of a uniform ProcessorGrid decomposition of
+   * the box and writes one file per subdomain
+   */
+  void writeSubdomainFiles(const float* coords, const int32_t* labels, size_t numAtoms, int32_t numAtomTypes, const float* boxMin, const float* boxMax);
+
+  /**
+   * @brief getSubdomainFileName Returns the output file of the subdomain with the given LAMMPS rank
+   */
+  QString getSubdomainFileName(int32_t rank) const;
+
+  /**
+   * @brief writeAtoms Writes the atoms in the selected output format
+   */
+  bool writeAtoms(FILE* f, const float* coords, const int32_t* labels, const size_t* atomIndices, size_t numAtoms, int32_t numAtomTypes, const float* boxMin, const float* boxMax);
+
+  /**
+   * @brief writeDataFile Writes the atoms as a LAMMPS data file (read_data) in the selected atom style, with
+   * the optional Masses and Velocities sections
+   * @param f Open output file
+   * @param coords Interleaved atom coordinates
+   * @param labels Atom feature label (atom type) of every atom
+   * @param atomIndices Indices of the atoms to write, or nullptr to write the atoms [0, numAtoms)
+   * @param numAtoms
+   * @param numAtomTypes
+   * @param boxMin Lower corner of the simulation box
+   * @param boxMax Upper corner of the simulation box
+   * @return false if the file could not be written
+   */
+  bool writeDataFile(FILE* f, const float* coords, const int32_t* labels, const size_t* atomIndices, size_t numAtoms, int32_t numAtomTypes, const float* boxMin, const float* boxMax);
+
+  /**
+   * @brief writeBinaryDump Writes the atoms as a binary LAMMPS dump with the columns "id type x y z", plus
+   * "mol", "q" and "vx vy vz" when the atom style and options provide them (read_dump, rerun)
+   * @return false if the file could not be written
+   */
+  bool writeBinaryDump(FILE* f, const float* coords, const int32_t* labels, const size_t* atomIndices, size_t numAtoms, const float* boxMin, const float* boxMax);
 
 public:
   ExportLAMMPSFile(const ExportLAMMPSFile&) = delete;            // Copy Constructor Not Implemented
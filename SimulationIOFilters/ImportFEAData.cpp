@@ -38,6 +38,7 @@
 
 #include "SimulationIO/SimulationIOConstants.h"
 #include "SimulationIO/SimulationIOVersion.h"
+#include "SimulationIO/SimulationIOFilters/util/ExternalJobRunner.h"
 
 #define READ_DEF_PT_TRACKING_TIME_INDEX "Time Index"
 
@@ -236,15 +237,12 @@ void ImportFEAData::dataCheck()
   clearWarningCode();
   setCancel(false);
 
-  m_Pause = false;
-  m_ProcessPtr.reset();
-
   switch(m_FEAPackage)
   {
   case 0:
   {
 
-    QStringList arguments = splitArgumentsString(m_ABQPythonCommand);
+    QStringList arguments = SimulationIO::ExternalJobRunner::SplitArguments(m_ABQPythonCommand);
     if(arguments.empty())
     {
       QString ss = QObject::tr("Abaqus python command to run a script has not been specified.");
@@ -513,19 +511,20 @@ void ImportFEAData::execute()
   {
   case 0: // ABAQUS
   {
-    // Check Output Path
-    QDir dir;
-    if(!dir.mkpath(m_odbFilePath))
+    // Check Output Path. The script and its files are addressed by absolute path, so the current directory of
+    // the process does not matter
+    QString odbFilePath = QDir(m_odbFilePath).absolutePath();
+    if(!QDir().mkpath(odbFilePath))
     {
-      QString ss = QObject::tr("Error in accessing odb file '%1'").arg(m_odbFilePath);
+      QString ss = QObject::tr("Error in accessing odb file '%1'").arg(odbFilePath);
       setErrorCondition(-1, ss);
       return;
     }
 
     // Create ABAQUS python script
-    QString abqpyscr = m_odbFilePath + QDir::separator() + m_odbName + ".py";
+    QString abqpyscr = odbFilePath + QDir::separator() + m_odbName + ".py";
     QString odbNamewExt = m_odbName + ".odb";
-    int err = writeABQpyscr(abqpyscr, odbNamewExt, m_odbFilePath, m_InstanceName, m_Step, m_FrameNumber);
+    int err = writeABQpyscr(abqpyscr, odbNamewExt, odbFilePath, m_InstanceName, m_Step, m_FrameNumber);
     if(err < 0)
     {
       QString ss = QObject::tr("Error writing ABAQUS python script '%1'").arg(abqpyscr);
@@ -534,14 +533,17 @@ void ImportFEAData::execute()
     }
 
     // Running ABAQUS python script
-    QString abqpyscrwExt = m_odbName + ".py";
-    runABQpyscr(abqpyscrwExt);
+    runABQpyscr(abqpyscr);
+    if(getErrorCode() < 0 || getCancel())
+    {
+      return;
+    }
 
     DataContainer::Pointer m = getDataContainerArray()->getDataContainer(getDataContainerName());
     AttributeMatrix::Pointer vertexAttrMat = m->getAttributeMatrix(getVertexAttributeMatrixName());
     AttributeMatrix::Pointer cellAttrMat = m->getAttributeMatrix(getCellAttributeMatrixName());
 
-    QString outTxtFile = m_odbFilePath + QDir::separator() + "odbtotxt.dat";
+    QString outTxtFile = odbFilePath + QDir::separator() + "odbtotxt.dat";
     scanABQFile(outTxtFile, m.get(), vertexAttrMat.get(), cellAttrMat.get());
 
     break;
@@ -630,7 +632,7 @@ int32_t ImportFEAData::writeABQpyscr(const QString& file, const QString& odbName
   fprintf(f, "odb = openOdb(path = odbfileName)\n");
   fprintf(f, "\n");
 
-  fprintf(f, "outTxtFile = 'odbtotxt.dat'\n");
+  fprintf(f, "outTxtFile = os.path.join(odbFilePath,'odbtotxt.dat')\n");
   fprintf(f, "fid = open(outTxtFile, \"a\")\n");
   fprintf(f, "\n");
 
@@ -715,173 +717,33 @@ void ImportFEAData::runABQpyscr(const QString& file)
 {
   // cmd to run: "abaqus python filename.py
 
-  QStringList arguments = splitArgumentsString(m_ABQPythonCommand);
-  QString program = arguments[0];
-
-  arguments.removeAt(0);
-
-  m_ProcessPtr = QSharedPointer<QProcess>(new QProcess(nullptr));
-  qRegisterMetaType<QProcess::ExitStatus>("QProcess::ExitStatus");
-  qRegisterMetaType<QProcess::ProcessError>("QProcess::ProcessError");
-  connect(m_ProcessPtr.data(), SIGNAL(finished(int, QProcess::ExitStatus)), this, SLOT(processHasFinished(int, QProcess::ExitStatus)), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(error(QProcess::ProcessError)), this, SLOT(processHasErroredOut(QProcess::ProcessError)), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(readyReadStandardError()), this, SLOT(sendErrorOutput()), Qt::QueuedConnection);
-  connect(m_ProcessPtr.data(), SIGNAL(readyReadStandardOutput()), this, SLOT(sendStandardOutput()), Qt::QueuedConnection);
-
-  m_ProcessPtr->setWorkingDirectory(m_odbFilePath);
-  m_ProcessPtr->start(program, arguments);
-  m_ProcessPtr->waitForStarted(2000);
-  m_ProcessPtr->waitForFinished(-1);
-
-  notifyStatusMessage("Finished running ABAQUS python script");
-}
-
-//
-//
-//
-
-QStringList ImportFEAData::splitArgumentsString(QString arguments)
-{
-  QStringList argumentList;
-  for(int i = 0; i < m_ABQPythonCommand.size(); i++)
-  {
-    if(m_ABQPythonCommand[i] == '\"')
-    {
-      i++;
-      int start = i;
-      int index = m_ABQPythonCommand.indexOf("\"", start);
-      if(index == -1)
-      {
-        index = m_ABQPythonCommand.size();
-      }
-      int end = index - 1;
-      argumentList.push_back(m_ABQPythonCommand.mid(start, end - start + 1));
-      i = index;
-    }
-    else
-    {
-      int start = i;
-      int index = m_ABQPythonCommand.indexOf(" ", start + 1);
-      if(index == -1)
-      {
-        index = m_ABQPythonCommand.size();
-      }
-      int end = index - 1;
-      argumentList.push_back(m_ABQPythonCommand.mid(start, end - start + 1));
-      i = index;
-    }
-  }
-
-  return argumentList;
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-
-void ImportFEAData::processHasFinished(int exitCode, QProcess::ExitStatus exitStatus)
-{
-  if(getCancel())
-  {
-  }
-  else if(exitStatus == QProcess::CrashExit)
-  {
-    QString ss = QObject::tr("The process crashed during its exit.");
-    setErrorCondition(-4003, ss);
-  }
-  else if(exitCode < 0)
-  {
-    QString ss = QObject::tr("The process finished with exit code %1.").arg(QString::number(exitCode));
-    setErrorCondition(-4004, ss);
-  }
-  else if(getErrorCode() >= 0)
-  {
-  }
-
-  m_Pause = false;
-  m_WaitCondition.wakeAll();
-}
+  QStringList arguments = SimulationIO::ExternalJobRunner::SplitArguments(m_ABQPythonCommand);
 
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
+  SimulationIO::ExternalJobRunner::Job job;
+  job.program = arguments.takeFirst();
+  job.arguments = arguments;
+  job.workingDirectory = QFileInfo(file).absolutePath();
 
-void ImportFEAData::processHasErroredOut(QProcess::ProcessError error)
-{
-  if(getCancel())
-  {
-    QString ss = QObject::tr("The process was killed by the user.");
-    setWarningCondition(-4004, ss);
-  }
-  else if(error == QProcess::FailedToStart)
-  {
-    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
-    QString pathEnv = env.value("PATH");
+  SimulationIO::ExternalJobRunner runner;
+  runner.setCancelCallback([this]() { return getCancel(); });
+  runner.setOutputCallback([this](int, const QString& line) { notifyStatusMessage(line); });
+  runner.addJob(job);
+  runner.run();
 
-    QString ss = QObject::tr("The process failed to start. Either the invoked program is missing, or you may have insufficient permissions to invoke the program \
-or the path containing the executble is not in the system's environment path. PATH=%1.\n Try using the absolute path to the executable.")
-                     .arg(pathEnv);
-    setErrorCondition(-4005, ss);
-  }
-  else if(error == QProcess::Crashed)
-  {
-    QString ss = QObject::tr("The process crashed some time after starting successfully.");
-    setErrorCondition(-4006, ss);
-  }
-  else if(error == QProcess::Timedout)
-  {
-    QString ss = QObject::tr("The process timed out.");
-    setErrorCondition(-4007, ss);
-  }
-  else if(error == QProcess::WriteError)
-  {
-    QString ss = QObject::tr("An error occurred when attempting to write to the process.");
-    setErrorCondition(-4008, ss);
-  }
-  else if(error == QProcess::ReadError)
-  {
-    QString ss = QObject::tr("An error occurred when attempting to read from the process.");
-    setErrorCondition(-4009, ss);
-  }
-  else
+  const SimulationIO::ExternalJobRunner::Result& result = runner.getResult(0);
+  if(result.status == SimulationIO::ExternalJobRunner::Status::Canceled)
   {
-    QString ss = QObject::tr("An unknown error occurred.");
-    setErrorCondition(-4010, ss);
+    setWarningCondition(-4004, runner.getErrorMessage(0));
+    return;
   }
-
-  m_Pause = false;
-  m_WaitCondition.wakeAll();
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
-
-void ImportFEAData::sendErrorOutput()
-{
-  if(m_ProcessPtr.data() != nullptr)
+  int errorCode = SimulationIO::ExternalJobRunner::ErrorCode(result);
+  if(errorCode < 0)
   {
-    QString error = m_ProcessPtr->readAllStandardError();
-    if(error[error.size() - 1] == '\n')
-    {
-      error.chop(1);
-    }
-    notifyStatusMessage(error);
-    m_WaitCondition.wakeAll();
+    setErrorCondition(errorCode, runner.getErrorMessage(0));
+    return;
   }
-}
-
-// -----------------------------------------------------------------------------
-//
-// -----------------------------------------------------------------------------
 
-void ImportFEAData::sendStandardOutput()
-{
-  if(m_ProcessPtr.data() != nullptr)
-  {
-    notifyStatusMessage(m_ProcessPtr->readAllStandardOutput());
-    m_WaitCondition.wakeAll();
-  }
+  notifyStatusMessage(QObject::tr("Finished running ABAQUS python script in %1").arg(SimulationIO::ExternalJobRunner::FormatTimes(runner.getWallTime(), runner.getCpuTime())));
 }
 
 // -----------------------------------------------------------------------------
@@ -5,10 +5,6 @@
 #pragma once
 
 #include <QtCore/QFile>
-#include <QtCore/QMutex>
-#include <QtCore/QProcess>
-#include <QtCore/QSharedPointer>
-#include <QtCore/QWaitCondition>
 
 #include "SIMPLib/Common/Constants.h"
 #include "SIMPLib/Common/SIMPLibSetGetMacros.h"
@@ -19,7 +15,6 @@
 
 class AttributeMatrix;
 class DataContainer;
-class QProcess;
 
 #include "SimulationIO/SimulationIODLLExport.h"
 
@@ -250,12 +245,6 @@ protected:
   QVector<QByteArray> tokenizeNodeBlock(QFile& reader);
   void parseDataTokens(QVector<QByteArray>& tokens, qint32 nodeIdx);
 
-protected slots:
-  void processHasFinished(int exitCode, QProcess::ExitStatus exitStatus);
-  void processHasErroredOut(QProcess::ProcessError error);
-  void sendErrorOutput();
-  void sendStandardOutput();
-
 private:
   /**
    * @brief writeABQpyscr
@@ -271,6 +260,10 @@ private:
    */
   int32_t writeABQpyscr(const QString& file, const QString& odbName, const QString& odbFilePath, const QString& instanceName, const QString& step, int frameNum);
 
+  /**
+   * @brief runABQpyscr Runs the ABAQUS python command in the directory of the script file
+   * @param file Absolute path of the script
+   */
   void runABQpyscr(const QString& file);
 
   void scanABQFile(const QString& file, DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix, AttributeMatrix* cellAttributeMatrix);
@@ -279,14 +272,6 @@ private:
 
   void scanBSAMFile(DataContainer* dataContainer, AttributeMatrix* vertexAttributeMatrix, AttributeMatrix* cellAttributeMatrix);
 
-  QWaitCondition m_WaitCondition;
-  QMutex m_Mutex;
-  bool m_Pause = false;
-  QSharedPointer<QProcess> m_ProcessPtr;
-  //  QStringList arguments;
-
-  QStringList splitArgumentsString(QString arguments);
-
   QString m_CachedFileName;
   QFile m_InStream;
   QMap<QString, QString> m_DataTypes;
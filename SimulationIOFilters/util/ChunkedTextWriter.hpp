@@ -0,0 +1,162 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The ChunkedTextWriter class writes a large, item oriented text section to an open file. The
+ * item range is split into chunks that are formatted independently into private buffers (in parallel
+ * when SIMPLib is built with TBB) and the buffers are then written to the file in order, one fwrite
+ * per chunk. Only a bounded batch of chunks is held in memory at any time.
+ *
+ * The formatter is called as formatter(buffer, start, end) and must append the text for the items
+ * [start, end) to the (empty) buffer without depending on the text of any other chunk.
+ */
+class ChunkedTextWriter
+{
+public:
+  using FormatterType = std::function<void(std::string& buffer, size_t start, size_t end)>;
+
+  explicit ChunkedTextWriter(FILE* file)
+  : m_File(file)
+  {
+  }
+
+  ~ChunkedTextWriter() = default;
+
+  /**
+   * @brief setChunkSize Sets the number of items formatted by one task
+   * @param numItems
+   */
+  void setChunkSize(size_t numItems)
+  {
+    m_ChunkSize = std::max<size_t>(numItems, 1);
+  }
+
+  size_t getChunkSize() const
+  {
+    return m_ChunkSize;
+  }
+
+  /**
+   * @brief write Formats the items [0, numItems) and appends them to the file
+   * @param numItems
+   * @param formatter
+   * @return false if the file could not be written
+   */
+  bool write(size_t numItems, const FormatterType& formatter) const
+  {
+    if(nullptr == m_File)
+    {
+      return false;
+    }
+
+    size_t numChunks = (numItems + m_ChunkSize - 1) / m_ChunkSize;
+    size_t batchSize = std::min(GetBatchSize(), numChunks);
+    std::vector<std::string> buffers(batchSize);
+
+    for(size_t firstChunk = 0; firstChunk < numChunks; firstChunk += batchSize)
+    {
+      size_t chunksInBatch = std::min(batchSize, numChunks - firstChunk);
+      FormatChunksImpl impl(formatter, buffers.data(), firstChunk, m_ChunkSize, numItems);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, chunksInBatch, 1), impl, tbb::simple_partitioner());
+#else
+      impl.convert(0, chunksInBatch);
+#endif
+      for(size_t c = 0; c < chunksInBatch; c++)
+      {
+        const std::string& buffer = buffers[c];
+        if(!buffer.empty() && fwrite(buffer.data(), 1, buffer.size(), m_File) != buffer.size())
+        {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief GetBatchSize Returns how many chunks are formatted before they are flushed to disk
+   */
+  static size_t GetBatchSize()
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    return 4 * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+#else
+    return 1;
+#endif
+  }
+
+private:
+  FILE* m_File = nullptr;
+  size_t m_ChunkSize = 65536;
+
+  /**
+   * @brief The FormatChunksImpl class formats a range of chunks of the current batch
+   */
+  class FormatChunksImpl
+  {
+  public:
+    FormatChunksImpl(const FormatterType& formatter, std::string* buffers, size_t firstChunk, size_t chunkSize, size_t numItems)
+    : m_Formatter(formatter)
+    , m_Buffers(buffers)
+    , m_FirstChunk(firstChunk)
+    , m_ChunkSize(chunkSize)
+    , m_NumItems(numItems)
+    {
+    }
+
+    void convert(size_t start, size_t end) const
+    {
+      for(size_t c = start; c < end; c++)
+      {
+        size_t begin = (m_FirstChunk + c) * m_ChunkSize;
+        size_t finish = std::min(begin + m_ChunkSize, m_NumItems);
+        m_Buffers[c].clear();
+        m_Formatter(m_Buffers[c], begin, finish);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      convert(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const FormatterType& m_Formatter;
+    std::string* m_Buffers;
+    size_t m_FirstChunk;
+    size_t m_ChunkSize;
+    size_t m_NumItems;
+  };
+
+public:
+  ChunkedTextWriter(const ChunkedTextWriter&) = delete;            // Copy Constructor Not Implemented
+  ChunkedTextWriter(ChunkedTextWriter&&) = delete;                 // Move Constructor Not Implemented
+  ChunkedTextWriter& operator=(const ChunkedTextWriter&) = delete; // Copy Assignment Not Implemented
+  ChunkedTextWriter& operator=(ChunkedTextWriter&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
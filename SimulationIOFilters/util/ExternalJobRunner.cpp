@@ -0,0 +1,450 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#include "ExternalJobRunner.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QDir>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFileInfo>
+#include <QtCore/QObject>
+#include <QtCore/QThread>
+#include <QtCore/QtGlobal>
+
+#ifndef Q_OS_WIN
+#include <sys/resource.h>
+#endif
+
+namespace SimulationIO
+{
+namespace
+{
+const int k_PollInterval = 100; // ms spent waiting on the running processes per pass
+const int k_KillTimeout = 1000; // ms to wait for a killed process
+
+/**
+ * @brief ChildrenCpuTime Returns the user and system time of all reaped child processes in seconds, or -1
+ */
+double ChildrenCpuTime()
+{
+#ifdef Q_OS_WIN
+  return -1.0;
+#else
+  struct rusage usage;
+  if(getrusage(RUSAGE_CHILDREN, &usage) != 0)
+  {
+    return -1.0;
+  }
+  return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) + 1.0e-6 * static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+#endif
+}
+} // namespace
+
+/**
+ * @brief The RunningJob struct is the process of a started job
+ */
+struct ExternalJobRunner::RunningJob
+{
+  int index = 0;
+  std::unique_ptr<QProcess> process;
+  QElapsedTimer timer;
+  QByteArray pendingOutput[2]; // Incomplete last lines of stdout and stderr
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExternalJobRunner::ExternalJobRunner() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ExternalJobRunner::~ExternalJobRunner() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExternalJobRunner::setMaxConcurrentJobs(int maxJobs)
+{
+  m_MaxConcurrentJobs = maxJobs;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExternalJobRunner::getMaxConcurrentJobs() const
+{
+  int maxJobs = (m_MaxConcurrentJobs > 0) ? m_MaxConcurrentJobs : QThread::idealThreadCount();
+  int queuedJobs = static_cast<int>(m_Jobs.size()) - m_NextJob;
+  return std::max(1, std::min(maxJobs, queuedJobs));
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExternalJobRunner::setCancelCallback(const CancelCallback& callback)
+{
+  m_CancelCallback = callback;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExternalJobRunner::setOutputCallback(const OutputCallback& callback)
+{
+  m_OutputCallback = callback;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExternalJobRunner::setFinishedCallback(const FinishedCallback& callback)
+{
+  m_FinishedCallback = callback;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExternalJobRunner::addJob(const Job& job)
+{
+  m_Jobs.push_back(job);
+  m_Results.emplace_back();
+  return static_cast<int>(m_Jobs.size()) - 1;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool ExternalJobRunner::run()
+{
+  QElapsedTimer runTimer;
+  runTimer.start();
+  double cpuStart = ChildrenCpuTime();
+
+  int numJobs = static_cast<int>(m_Jobs.size());
+  size_t maxJobs = static_cast<size_t>(getMaxConcurrentJobs());
+  std::vector<std::unique_ptr<RunningJob>> running;
+  bool stopped = false;
+
+  while(true)
+  {
+    if(!stopped && m_CancelCallback && m_CancelCallback())
+    {
+      stopped = true;
+    }
+
+    while(!stopped && m_NextJob < numJobs && running.size() < maxJobs)
+    {
+      std::unique_ptr<RunningJob> job(new RunningJob);
+      job->index = m_NextJob++;
+      startJob(*job);
+      running.push_back(std::move(job));
+    }
+
+    if(running.empty())
+    {
+      break;
+    }
+
+    if(stopped)
+    {
+      for(const std::unique_ptr<RunningJob>& job : running)
+      {
+        job->process->kill();
+        job->process->waitForFinished(k_KillTimeout);
+        Result& result = m_Results[job->index];
+        result.status = Status::Canceled;
+        result.wallTime = static_cast<double>(job->timer.elapsed()) / 1000.0;
+      }
+      running.clear();
+      break;
+    }
+
+    int slice = std::max(1, k_PollInterval / static_cast<int>(running.size()));
+    for(auto iter = running.begin(); iter != running.end();)
+    {
+      RunningJob& job = **iter;
+      QProcess* process = job.process.get();
+      Result& result = m_Results[job.index];
+      if(process->state() != QProcess::NotRunning && !process->waitForFinished(slice))
+      {
+        forwardOutput(job, false);
+        int timeout = m_Jobs[job.index].timeout;
+        if(timeout <= 0 || job.timer.elapsed() <= timeout)
+        {
+          ++iter;
+          continue;
+        }
+        process->kill();
+        process->waitForFinished(k_KillTimeout);
+        forwardOutput(job, true);
+        result.status = Status::TimedOut;
+      }
+      else
+      {
+        forwardOutput(job, true);
+        if(process->error() == QProcess::FailedToStart)
+        {
+          result.status = Status::FailedToStart;
+        }
+        else if(process->exitStatus() == QProcess::CrashExit)
+        {
+          result.status = Status::Crashed;
+        }
+        else
+        {
+          result.status = Status::Finished;
+          result.exitCode = process->exitCode();
+        }
+      }
+
+      result.wallTime = static_cast<double>(job.timer.elapsed()) / 1000.0;
+
+      int index = job.index;
+      iter = running.erase(iter);
+      if(m_FinishedCallback && !m_FinishedCallback(index, m_Results[index]))
+      {
+        stopped = true;
+      }
+    }
+  }
+
+  // The usage of reaped children is only known for the whole process, not per job or per runner
+  m_WallTime = static_cast<double>(runTimer.elapsed()) / 1000.0;
+  double cpuEnd = ChildrenCpuTime();
+  m_CpuTime = (cpuEnd >= 0.0 && cpuStart >= 0.0) ? cpuEnd - cpuStart : -1.0;
+  return !stopped;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExternalJobRunner::startJob(RunningJob& running)
+{
+  const Job& job = m_Jobs[running.index];
+  running.process.reset(new QProcess(nullptr));
+  QProcess* process = running.process.get();
+  process->setProcessEnvironment(job.environment);
+
+  if(!job.workingDirectory.isEmpty())
+  {
+    QDir().mkpath(job.workingDirectory);
+    process->setWorkingDirectory(job.workingDirectory);
+  }
+
+  if(!job.logFile.isEmpty())
+  {
+    process->setProcessChannelMode(QProcess::MergedChannels);
+    process->setStandardOutputFile(job.logFile);
+  }
+  else if(!m_OutputCallback)
+  {
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setStandardErrorFile(QProcess::nullDevice());
+  }
+
+  running.timer.start();
+  process->start(job.program, job.arguments);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void ExternalJobRunner::forwardOutput(RunningJob& running, bool flush)
+{
+  if(!m_OutputCallback || !m_Jobs[running.index].logFile.isEmpty())
+  {
+    return;
+  }
+
+  running.pendingOutput[0] += running.process->readAllStandardOutput();
+  running.pendingOutput[1] += running.process->readAllStandardError();
+  for(QByteArray& buffer : running.pendingOutput)
+  {
+    int start = 0;
+    int end = buffer.indexOf('\n');
+    while(end >= 0 || (flush && start < buffer.size()))
+    {
+      if(end < 0)
+      {
+        end = buffer.size();
+      }
+      QString line = QString::fromLocal8Bit(buffer.constData() + start, end - start);
+      if(line.endsWith('\r'))
+      {
+        line.chop(1);
+      }
+      if(!line.isEmpty())
+      {
+        m_OutputCallback(running.index, line);
+      }
+      start = end + 1;
+      end = (start < buffer.size()) ? buffer.indexOf('\n', start) : -1;
+    }
+    buffer.remove(0, std::min(start, buffer.size()));
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExternalJobRunner::getNumberOfJobs() const
+{
+  return static_cast<int>(m_Jobs.size());
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const ExternalJobRunner::Job& ExternalJobRunner::getJob(int job) const
+{
+  return m_Jobs[job];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const ExternalJobRunner::Result& ExternalJobRunner::getResult(int job) const
+{
+  return m_Results[job];
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double ExternalJobRunner::getWallTime() const
+{
+  return m_WallTime;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+double ExternalJobRunner::getCpuTime() const
+{
+  return m_CpuTime;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExternalJobRunner::getErrorMessage(int job) const
+{
+  const Job& description = m_Jobs[job];
+  const Result& result = m_Results[job];
+  QString program = QFileInfo(description.program).fileName();
+
+  QString ss;
+  switch(result.status)
+  {
+  case Status::NotStarted:
+    ss = QObject::tr("%1 was not started").arg(program);
+    break;
+  case Status::Finished:
+    if(result.exitCode != 0)
+    {
+      ss = QObject::tr("%1 finished with exit code %2").arg(program).arg(result.exitCode);
+    }
+    break;
+  case Status::FailedToStart:
+    ss = QObject::tr("%1 failed to start. Either the program is missing, or you may have insufficient permissions \
+or the path containing the executable is not in the system's environment path. PATH=%2.\n Try using the absolute path to the executable.")
+             .arg(description.program)
+             .arg(description.environment.value("PATH"));
+    break;
+  case Status::Crashed:
+    ss = QObject::tr("%1 crashed some time after starting successfully").arg(program);
+    break;
+  case Status::TimedOut:
+    ss = QObject::tr("%1 did not finish within %2 s and was killed").arg(program).arg(description.timeout / 1000.0);
+    break;
+  case Status::Canceled:
+    ss = QObject::tr("%1 was killed by the user").arg(program);
+    break;
+  }
+
+  if(!ss.isEmpty() && !description.logFile.isEmpty() && result.status != Status::FailedToStart)
+  {
+    ss += QObject::tr(". See %1").arg(description.logFile);
+  }
+  return ss;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+int ExternalJobRunner::ErrorCode(const Result& result)
+{
+  switch(result.status)
+  {
+  case Status::Finished:
+    return (result.exitCode != 0) ? -4004 : 0;
+  case Status::FailedToStart:
+    return -4005;
+  case Status::Crashed:
+    return -4006;
+  case Status::TimedOut:
+    return -4007;
+  default:
+    return 0;
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ExternalJobRunner::FormatTimes(double wallTime, double cpuTime)
+{
+  if(cpuTime < 0.0)
+  {
+    return QObject::tr("%1 s").arg(wallTime, 0, 'f', 1);
+  }
+  return QObject::tr("%1 s (CPU of all child processes of DREAM.3D %2 s)").arg(wallTime, 0, 'f', 1).arg(cpuTime, 0, 'f', 1);
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList ExternalJobRunner::SplitArguments(const QString& command)
+{
+  QStringList arguments;
+  QString argument;
+  bool inQuotes = false;
+  bool hasArgument = false;
+  for(QChar c : command)
+  {
+    if(c == '\"')
+    {
+      inQuotes = !inQuotes;
+      hasArgument = true;
+    }
+    else if(c.isSpace() && !inQuotes)
+    {
+      if(hasArgument)
+      {
+        arguments << argument;
+        argument.clear();
+        hasArgument = false;
+      }
+    }
+    else
+    {
+      argument += c;
+      hasArgument = true;
+    }
+  }
+  if(hasArgument)
+  {
+    arguments << argument;
+  }
+  return arguments;
+}
+
+} // namespace SimulationIO
@@ -0,0 +1,180 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <QtCore/QProcess>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SimulationIO/SimulationIODLLExport.h"
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The ExternalJobRunner class runs external programs (meshing packages, ABAQUS python, ...) for the filters.
+ * Jobs are queued with addJob() and run() then starts them in order, keeping up to setMaxConcurrentJobs() processes
+ * running at the same time, until every job has finished, the cancel callback returns true or the finished callback
+ * returns false. Every job has its own working directory, environment and optional timeout, and either writes its
+ * output to a log file or has it forwarded line by line to the output callback. The wall time of every job and the
+ * wall and CPU time of every run() are measured.
+ *
+ * run() blocks the calling thread (the filter's execute()) and polls the processes, so no event loop is needed.
+ * The callbacks are called from that thread.
+ *
+ * CPU time is only reported per run(): it is the user and system time of all child processes of DREAM.3D that were
+ * reaped while run() was going (getrusage(RUSAGE_CHILDREN)). That covers the whole process, so it includes the jobs
+ * of other runners, e.g. of other filters running at the same time. It is not available on Windows (-1).
+ */
+class SimulationIO_EXPORT ExternalJobRunner
+{
+public:
+  /**
+   * @brief The Job struct describes one run of an external program
+   */
+  struct Job
+  {
+    QString program;
+    QStringList arguments;
+    // Created if it does not exist; empty for the current directory of the process
+    QString workingDirectory;
+    QProcessEnvironment environment = QProcessEnvironment::systemEnvironment();
+    // If set, stdout and stderr go to this file instead of the output callback
+    QString logFile;
+    // ms; 0 waits forever
+    int timeout = 0;
+  };
+
+  enum class Status : int
+  {
+    NotStarted,
+    Finished, // Exited normally, with any exit code
+    FailedToStart,
+    Crashed,
+    TimedOut,
+    Canceled // Killed because run() was canceled or stopped
+  };
+
+  /**
+   * @brief The Result struct is the outcome of one job
+   */
+  struct Result
+  {
+    Status status = Status::NotStarted;
+    int exitCode = 0;
+    double wallTime = 0.0; // s
+  };
+
+  using CancelCallback = std::function<bool()>;
+  using OutputCallback = std::function<void(int job, const QString& line)>;
+  using FinishedCallback = std::function<bool(int job, const Result& result)>;
+
+  ExternalJobRunner();
+  ~ExternalJobRunner();
+
+  /**
+   * @brief setMaxConcurrentJobs Sets how many processes run at the same time; 0 (default) runs one per core
+   */
+  void setMaxConcurrentJobs(int maxJobs);
+
+  /**
+   * @brief getMaxConcurrentJobs Returns the number of processes run() keeps running for the queued jobs
+   */
+  int getMaxConcurrentJobs() const;
+
+  /**
+   * @brief setCancelCallback Sets the function polled while jobs run; when it returns true the running jobs are
+   * killed and no further jobs are started
+   */
+  void setCancelCallback(const CancelCallback& callback);
+
+  /**
+   * @brief setOutputCallback Sets the function that receives every line a job without log file writes to stdout
+   * or stderr. Without it that output is discarded.
+   */
+  void setOutputCallback(const OutputCallback& callback);
+
+  /**
+   * @brief setFinishedCallback Sets the function called when a job ends on its own (it was not killed by a cancel
+   * or stop); when it returns false the running jobs are killed and no further jobs are started
+   */
+  void setFinishedCallback(const FinishedCallback& callback);
+
+  /**
+   * @brief addJob Queues a job
+   * @return Index of the job
+   */
+  int addJob(const Job& job);
+
+  /**
+   * @brief run Runs the queued jobs that have not been run yet
+   * @return false if the jobs were canceled or stopped by the finished callback
+   */
+  bool run();
+
+  int getNumberOfJobs() const;
+  const Job& getJob(int job) const;
+  const Result& getResult(int job) const;
+
+  /**
+   * @brief getWallTime Returns the time the last run() took, in seconds
+   */
+  double getWallTime() const;
+
+  /**
+   * @brief getCpuTime Returns the CPU time of all child processes of DREAM.3D that ended during the last run(), in
+   * seconds, or -1 if not available. This includes processes that were not started by this runner.
+   */
+  double getCpuTime() const;
+
+  /**
+   * @brief getErrorMessage Returns what went wrong with a job, or an empty string if it finished with exit code 0
+   */
+  QString getErrorMessage(int job) const;
+
+  /**
+   * @brief ErrorCode Returns the filter error code of a job result: -4004 for a nonzero exit code, -4005 if the
+   * program failed to start, -4006 if it crashed, -4007 if it timed out, and 0 otherwise
+   */
+  static int ErrorCode(const Result& result);
+
+  /**
+   * @brief FormatTimes Returns the wall time and the CPU time of the child processes of a run() for status messages
+   */
+  static QString FormatTimes(double wallTime, double cpuTime);
+
+  /**
+   * @brief SplitArguments Splits a command line into the program and its arguments. Arguments are separated by
+   * white space; double quotes group white space into an argument and are removed.
+   */
+  static QStringList SplitArguments(const QString& command);
+
+private:
+  struct RunningJob;
+
+  std::vector<Job> m_Jobs;
+  std::vector<Result> m_Results;
+  int m_NextJob = 0;
+  int m_MaxConcurrentJobs = 0;
+  double m_WallTime = 0.0;
+  double m_CpuTime = -1.0;
+  CancelCallback m_CancelCallback;
+  OutputCallback m_OutputCallback;
+  FinishedCallback m_FinishedCallback;
+
+  void startJob(RunningJob& running);
+  void forwardOutput(RunningJob& running, bool flush);
+
+public:
+  ExternalJobRunner(const ExternalJobRunner&) = delete;            // Copy Constructor Not Implemented
+  ExternalJobRunner(ExternalJobRunner&&) = delete;                 // Move Constructor Not Implemented
+  ExternalJobRunner& operator=(const ExternalJobRunner&) = delete; // Copy Assignment Not Implemented
+  ExternalJobRunner& operator=(ExternalJobRunner&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
@@ -0,0 +1,120 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+#include <QtCore/QFile>
+#include <QtCore/QString>
+#include <QtCore/QtGlobal>
+
+#if defined(Q_OS_LINUX)
+#include <cerrno>
+#include <sys/sendfile.h>
+#include <unistd.h>
+#endif
+
+namespace SimulationIO
+{
+namespace FileCopy
+{
+/**
+ * @brief Size of the buffer used when the operating system cannot copy the bytes itself
+ */
+const qint64 k_CopyBufferSize = 8 * 1024 * 1024;
+
+#if defined(Q_OS_LINUX)
+/**
+ * @brief KernelCopy Moves up to count bytes from the current offset of inFd to the current offset of outFd
+ * without passing them through user space. copy_file_range is tried first (it can share extents on file systems
+ * that support it), then sendfile.
+ * @return The number of bytes copied, or -1 if neither call is supported for this pair of files
+ */
+inline qint64 KernelCopy(int inFd, int outFd, qint64 count)
+{
+  ssize_t n = -1;
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 27))
+  n = copy_file_range(inFd, nullptr, outFd, nullptr, static_cast<size_t>(count), 0);
+  if(n >= 0)
+  {
+    return n;
+  }
+#endif
+  n = sendfile(outFd, inFd, nullptr, static_cast<size_t>(count));
+  return n;
+}
+#endif
+
+/**
+ * @brief AppendFileContents Appends the complete contents of the file at inputPath to the end of out. The bytes
+ * are copied as is (no line ending translation) in large blocks: by the kernel on Linux and with a large buffer
+ * everywhere else or when the kernel copy is not supported for the two files.
+ * @param out Output file, opened for writing in binary mode. Its stdio buffer is flushed first.
+ * @param inputPath
+ * @return false if the input file could not be read or the output file could not be written
+ */
+inline bool AppendFileContents(FILE* out, const QString& inputPath)
+{
+  QFile in(inputPath);
+  if(!in.open(QIODevice::ReadOnly))
+  {
+    return false;
+  }
+  if(fflush(out) != 0)
+  {
+    return false;
+  }
+
+  qint64 remaining = in.size();
+
+#if defined(Q_OS_LINUX)
+  int inFd = in.handle();
+  int outFd = fileno(out);
+  bool kernelCopied = false;
+  while(remaining > 0)
+  {
+    qint64 n = KernelCopy(inFd, outFd, remaining);
+    if(n <= 0)
+    {
+      break;
+    }
+    remaining -= n;
+    kernelCopied = true;
+  }
+  if(kernelCopied && fseek(out, 0, SEEK_END) != 0) // re-synchronize the stdio position with the file descriptor
+  {
+    return false;
+  }
+  if(remaining > 0 && !in.seek(in.size() - remaining))
+  {
+    return false;
+  }
+#endif
+
+  if(remaining > 0)
+  {
+    std::vector<char> buffer(static_cast<size_t>(std::min(remaining, k_CopyBufferSize)));
+    while(remaining > 0)
+    {
+      qint64 n = in.read(buffer.data(), static_cast<qint64>(buffer.size()));
+      if(n <= 0)
+      {
+        return false;
+      }
+      if(fwrite(buffer.data(), 1, static_cast<size_t>(n), out) != static_cast<size_t>(n))
+      {
+        return false;
+      }
+      remaining -= n;
+    }
+  }
+
+  return true;
+}
+
+} // namespace FileCopy
+} // namespace SimulationIO
@@ -0,0 +1,589 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#include "NetgenVolMerger.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QObject>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "SimulationIO/SimulationIOFilters/util/ChunkedTextWriter.hpp"
+#include "SimulationIO/SimulationIOFilters/util/TextFormatting.hpp"
+#include "SimulationIO/SimulationIOFilters/util/TextParsing.hpp"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace SimulationIO
+{
+namespace
+{
+const size_t k_NumOffsetKinds = 5;
+
+/**
+ * @brief Section Location of one counted section ("keyword", count, records) in a mapped file
+ */
+struct Section
+{
+  std::string name;
+  NetgenVolMerger::SectionKind kind = NetgenVolMerger::SectionKind::Unknown;
+  const char* begin = nullptr;
+  const char* end = nullptr;
+  size_t count = 0;
+};
+
+/**
+ * @brief LastNumberedColumn Returns the index of the last column of a record that can refer to a numbering, so
+ * everything after it can be copied as is
+ */
+size_t LastNumberedColumn(NetgenVolMerger::SectionKind kind, int64_t numPoints)
+{
+  switch(kind)
+  {
+  case NetgenVolMerger::SectionKind::SurfaceElements:
+    return 4 + static_cast<size_t>(std::max<int64_t>(numPoints, 0));
+  case NetgenVolMerger::SectionKind::VolumeElements:
+    return 1 + static_cast<size_t>(std::max<int64_t>(numPoints, 0));
+  case NetgenVolMerger::SectionKind::EdgeSegments:
+    return 3;
+  case NetgenVolMerger::SectionKind::EdgeSegmentsGI2:
+    return 10;
+  case NetgenVolMerger::SectionKind::Materials:
+  case NetgenVolMerger::SectionKind::FaceColours:
+    return 0;
+  default:
+    break;
+  }
+  return 0;
+}
+
+/**
+ * @brief VisitRecord Walks the columns of the record on the line that starts at p up to its last numbered column
+ * and calls visit(tokenBegin, tokenEnd, offsetKind, value) for each of them. value is only parsed for numbered
+ * columns.
+ * @return The end of the last visited token, or nullptr if the record is malformed
+ */
+template <typename Visitor>
+const char* VisitRecord(NetgenVolMerger::SectionKind kind, const char* p, const char* lineEnd, Visitor&& visit)
+{
+  int64_t numPoints = 0;
+  // The "np" column comes before the point columns, so the last column is only known after reading it
+  size_t npColumn = (kind == NetgenVolMerger::SectionKind::SurfaceElements) ? 4 : ((kind == NetgenVolMerger::SectionKind::VolumeElements) ? 1 : SIZE_MAX);
+  size_t lastColumn = (npColumn == SIZE_MAX) ? LastNumberedColumn(kind, 0) : npColumn;
+  for(size_t column = 0; column <= lastColumn; column++)
+  {
+    const char* tokenBegin = TextParsing::SkipBlanks(p, lineEnd);
+    const char* tokenEnd = TextParsing::TokenEnd(tokenBegin, lineEnd);
+    if(tokenBegin == tokenEnd)
+    {
+      return nullptr;
+    }
+    NetgenVolMerger::OffsetKind offsetKind = NetgenVolMerger::GetColumnKind(kind, column, numPoints);
+    int64_t value = 0;
+    if(offsetKind != NetgenVolMerger::OffsetKind::None || column == npColumn)
+    {
+      const char* q = tokenBegin;
+      if(!TextParsing::ParseInt(q, tokenEnd, value) || q != tokenEnd)
+      {
+        return nullptr;
+      }
+    }
+    if(column == npColumn)
+    {
+      numPoints = value;
+      lastColumn = LastNumberedColumn(kind, numPoints);
+    }
+    visit(tokenBegin, tokenEnd, offsetKind, value);
+    p = tokenEnd;
+  }
+  return p;
+}
+
+/**
+ * @brief LineEnd Returns the end of the line that contains p, without the line feed and a carriage return before it
+ */
+const char* LineEnd(const char* p, const char* end)
+{
+  const char* lineEnd = TextParsing::NextLine(p, end);
+  if(lineEnd > p && lineEnd[-1] == '\n')
+  {
+    --lineEnd;
+  }
+  if(lineEnd > p && lineEnd[-1] == '\r')
+  {
+    --lineEnd;
+  }
+  return lineEnd;
+}
+} // namespace
+
+/**
+ * @brief The VolFile struct holds a mapped input file and what the scan found in it
+ */
+struct NetgenVolMerger::VolFile
+{
+  QString path;
+  QFile file;
+  QByteArray buffer;
+  const char* data = nullptr;
+  size_t size = 0;
+
+  int64_t dimension = 3;
+  int64_t geomType = 0;
+  std::vector<Section> sections;
+  size_t numPoints = 0;
+  int64_t maxValues[k_NumOffsetKinds] = {0, 0, 0, 0, 0};
+  int64_t offsets[k_NumOffsetKinds] = {0, 0, 0, 0, 0};
+  QString error;
+
+  /**
+   * @brief scan Maps the file and records its sections, point count and the largest number of each numbering
+   */
+  void scan()
+  {
+    file.setFileName(path);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+      error = QObject::tr("Netgen mesh file could not be opened: %1").arg(path);
+      return;
+    }
+    uchar* mapped = (file.size() > 0) ? file.map(0, file.size()) : nullptr;
+    if(nullptr != mapped)
+    {
+      data = reinterpret_cast<const char*>(mapped);
+      size = static_cast<size_t>(file.size());
+    }
+    else
+    {
+      buffer = file.readAll();
+      data = buffer.constData();
+      size = static_cast<size_t>(buffer.size());
+    }
+
+    const char* p = data;
+    const char* end = data + size;
+    while(true)
+    {
+      p = TextParsing::SkipEmptyLines(p, end);
+      if(p == end)
+      {
+        break;
+      }
+      const char* keywordBegin = TextParsing::SkipBlanks(p, end);
+      std::string keyword(keywordBegin, TextParsing::TokenEnd(keywordBegin, end));
+      p = TextParsing::NextLine(p, end);
+
+      if(keyword == "mesh3d" || keyword == "mesh2d")
+      {
+        continue;
+      }
+      if(keyword == "endmesh")
+      {
+        break;
+      }
+      if(keyword == "dimension" || keyword == "geomtype")
+      {
+        p = TextParsing::SkipEmptyLines(p, end);
+        int64_t value = 0;
+        if(!TextParsing::ParseInt(p, end, value))
+        {
+          error = QObject::tr("Missing value after '%1' in %2").arg(QString::fromStdString(keyword)).arg(path);
+          return;
+        }
+        (keyword == "dimension" ? dimension : geomType) = value;
+        p = TextParsing::NextLine(p, end);
+        continue;
+      }
+
+      // Every other section is "keyword", a record count and that many records
+      Section section;
+      section.name = keyword;
+      section.kind = GetSectionKind(QString::fromStdString(keyword));
+      p = TextParsing::SkipEmptyLines(p, end);
+      int64_t count = 0;
+      if(!TextParsing::ParseInt(p, end, count) || count < 0)
+      {
+        error = QObject::tr("Missing record count after '%1' in %2").arg(QString::fromStdString(keyword)).arg(path);
+        return;
+      }
+      p = TextParsing::NextLine(p, end);
+      section.begin = p;
+      section.count = static_cast<size_t>(count);
+
+      for(size_t i = 0; i < section.count; i++)
+      {
+        p = TextParsing::SkipEmptyLines(p, end);
+        if(p == end)
+        {
+          error = QObject::tr("Section '%1' of %2 ends after %3 of %4 records").arg(QString::fromStdString(keyword)).arg(path).arg(i).arg(section.count);
+          return;
+        }
+        if(section.kind != SectionKind::Unknown && section.kind != SectionKind::Points)
+        {
+          const char* lineEnd = LineEnd(p, end);
+          const char* last = VisitRecord(section.kind, p, lineEnd, [this](const char*, const char*, OffsetKind offsetKind, int64_t value) {
+            size_t k = static_cast<size_t>(offsetKind);
+            maxValues[k] = std::max(maxValues[k], value);
+          });
+          if(nullptr == last)
+          {
+            error = QObject::tr("Malformed record %1 in section '%2' of %3").arg(i + 1).arg(QString::fromStdString(keyword)).arg(path);
+            return;
+          }
+        }
+        p = TextParsing::NextLine(p, end);
+      }
+      section.end = p;
+
+      if(section.kind == SectionKind::Points)
+      {
+        numPoints += section.count;
+      }
+      sections.push_back(section);
+    }
+  }
+
+  /**
+   * @brief format Appends the records of every section called name to buffer, renumbered with this file's offsets
+   */
+  void format(const std::string& name, std::string& buffer) const
+  {
+    char number[TextFormatting::k_MaxCharsPerValue];
+    for(const Section& section : sections)
+    {
+      if(section.name != name)
+      {
+        continue;
+      }
+      if(section.kind == SectionKind::Points)
+      {
+        buffer.append(section.begin, static_cast<size_t>(section.end - section.begin));
+        if(section.end > section.begin && section.end[-1] != '\n')
+        {
+          buffer.push_back('\n');
+        }
+        continue;
+      }
+
+      const char* end = section.end;
+      for(const char* p = section.begin; p < end; p = TextParsing::NextLine(p, end))
+      {
+        if(TextParsing::IsEndOfLine(p, end))
+        {
+          continue;
+        }
+        const char* lineEnd = LineEnd(p, end);
+        bool first = true;
+        const char* last = VisitRecord(section.kind, p, lineEnd, [&](const char* tokenBegin, const char* tokenEnd, OffsetKind offsetKind, int64_t value) {
+          if(!first)
+          {
+            buffer.push_back(' ');
+          }
+          first = false;
+          if(offsetKind == OffsetKind::None || value <= 0)
+          {
+            buffer.append(tokenBegin, static_cast<size_t>(tokenEnd - tokenBegin));
+            return;
+          }
+          char* numberEnd = TextFormatting::FormatInt(number, value + offsets[static_cast<size_t>(offsetKind)]);
+          buffer.append(number, static_cast<size_t>(numberEnd - number));
+        });
+        // The scan already validated every record
+        buffer.append(last, static_cast<size_t>(lineEnd - last));
+        buffer.push_back('\n');
+      }
+    }
+  }
+};
+
+/**
+ * @brief The ScanVolFilesImpl class scans a range of the input files
+ */
+class ScanVolFilesImpl
+{
+public:
+  explicit ScanVolFilesImpl(std::vector<std::unique_ptr<NetgenVolMerger::VolFile>>& files)
+  : m_Files(files)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t i = start; i < end; i++)
+    {
+      m_Files[i]->scan();
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  std::vector<std::unique_ptr<NetgenVolMerger::VolFile>>& m_Files;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NetgenVolMerger::NetgenVolMerger() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NetgenVolMerger::~NetgenVolMerger() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NetgenVolMerger::SectionKind NetgenVolMerger::GetSectionKind(const QString& keyword)
+{
+  if(keyword == "surfaceelements" || keyword == "surfaceelementsgi" || keyword == "surfaceelementsuv")
+  {
+    return SectionKind::SurfaceElements;
+  }
+  if(keyword == "volumeelements")
+  {
+    return SectionKind::VolumeElements;
+  }
+  if(keyword == "edgesegments" || keyword == "edgesegmentsgi")
+  {
+    return SectionKind::EdgeSegments;
+  }
+  if(keyword == "edgesegmentsgi2")
+  {
+    return SectionKind::EdgeSegmentsGI2;
+  }
+  if(keyword == "points")
+  {
+    return SectionKind::Points;
+  }
+  if(keyword == "materials")
+  {
+    return SectionKind::Materials;
+  }
+  if(keyword == "face_colours")
+  {
+    return SectionKind::FaceColours;
+  }
+  return SectionKind::Unknown;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+NetgenVolMerger::OffsetKind NetgenVolMerger::GetColumnKind(SectionKind kind, size_t column, int64_t numPoints)
+{
+  switch(kind)
+  {
+  case SectionKind::SurfaceElements:
+    // surfnr bcnr domin domout np p1 ... pnp [geometry info]
+    if(column == 0)
+    {
+      return OffsetKind::Surface;
+    }
+    if(column == 2 || column == 3)
+    {
+      return OffsetKind::Domain;
+    }
+    if(column >= 5 && static_cast<int64_t>(column) < 5 + numPoints)
+    {
+      return OffsetKind::Point;
+    }
+    break;
+  case SectionKind::VolumeElements:
+    // matnr np p1 ... pnp
+    if(column == 0)
+    {
+      return OffsetKind::Domain;
+    }
+    if(column >= 2 && static_cast<int64_t>(column) < 2 + numPoints)
+    {
+      return OffsetKind::Point;
+    }
+    break;
+  case SectionKind::EdgeSegments:
+    // surfid 0 p1 p2 [geometry info]
+    if(column == 0)
+    {
+      return OffsetKind::Surface;
+    }
+    if(column == 2 || column == 3)
+    {
+      return OffsetKind::Point;
+    }
+    break;
+  case SectionKind::EdgeSegmentsGI2:
+    // surfid 0 p1 p2 trignum1 trignum2 surfnr1 surfnr2 ednr1 dist1 ednr2 dist2
+    if(column == 0 || column == 6 || column == 7)
+    {
+      return OffsetKind::Surface;
+    }
+    if(column == 2 || column == 3)
+    {
+      return OffsetKind::Point;
+    }
+    if(column == 8 || column == 10)
+    {
+      return OffsetKind::Edge;
+    }
+    break;
+  case SectionKind::Materials:
+    // matnr name
+    if(column == 0)
+    {
+      return OffsetKind::Domain;
+    }
+    break;
+  case SectionKind::FaceColours:
+    // surfnr red green blue
+    if(column == 0)
+    {
+      return OffsetKind::Surface;
+    }
+    break;
+  default:
+    break;
+  }
+  return OffsetKind::None;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool NetgenVolMerger::merge(const QStringList& inputFiles, const QString& outputFile)
+{
+  m_ErrorMessage.clear();
+  m_DroppedSections.clear();
+
+  QString outputPath = QFileInfo(outputFile).absoluteFilePath();
+  std::vector<std::unique_ptr<VolFile>> files;
+  for(const QString& inputFile : inputFiles)
+  {
+    if(QFileInfo(inputFile).absoluteFilePath() == outputPath)
+    {
+      m_ErrorMessage = QObject::tr("The merged mesh file may not be one of the input files: %1").arg(outputFile);
+      return false;
+    }
+    files.emplace_back(new VolFile);
+    files.back()->path = inputFile;
+  }
+
+  ScanVolFilesImpl scanImpl(files);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, files.size(), 1), scanImpl, tbb::simple_partitioner());
+#else
+  scanImpl.convert(0, files.size());
+#endif
+
+  // Section order of the merged file is the order in which the sections first appear
+  std::vector<std::string> sectionNames;
+  std::vector<size_t> sectionCounts;
+  for(size_t i = 0; i < files.size(); i++)
+  {
+    VolFile& volFile = *files[i];
+    if(!volFile.error.isEmpty())
+    {
+      m_ErrorMessage = volFile.error;
+      return false;
+    }
+    if(i > 0)
+    {
+      const VolFile& previous = *files[i - 1];
+      volFile.offsets[static_cast<size_t>(OffsetKind::Point)] = previous.offsets[static_cast<size_t>(OffsetKind::Point)] + static_cast<int64_t>(previous.numPoints);
+      for(size_t k = static_cast<size_t>(OffsetKind::Surface); k < k_NumOffsetKinds; k++)
+      {
+        volFile.offsets[k] = previous.offsets[k] + previous.maxValues[k];
+      }
+    }
+    for(const Section& section : volFile.sections)
+    {
+      if(section.kind == SectionKind::Unknown)
+      {
+        QString name = QString::fromStdString(section.name);
+        if(!m_DroppedSections.contains(name))
+        {
+          m_DroppedSections << name;
+        }
+        continue;
+      }
+      size_t index = static_cast<size_t>(std::find(sectionNames.begin(), sectionNames.end(), section.name) - sectionNames.begin());
+      if(index == sectionNames.size())
+      {
+        sectionNames.push_back(section.name);
+        sectionCounts.push_back(0);
+      }
+      sectionCounts[index] += section.count;
+    }
+  }
+
+  FILE* f = fopen(outputFile.toLocal8Bit().data(), "wb");
+  if(nullptr == f)
+  {
+    m_ErrorMessage = QObject::tr("Merged mesh file could not be created: %1").arg(outputFile);
+    return false;
+  }
+
+  int64_t dimension = files.empty() ? 3 : files.front()->dimension;
+  int64_t geomType = files.empty() ? 0 : files.front()->geomType;
+  fprintf(f, "mesh3d\ndimension\n%lld\ngeomtype\n%lld\n", static_cast<long long int>(dimension), static_cast<long long int>(geomType));
+
+  // Each file's part of a section is formatted independently; the parts are written in file order
+  ChunkedTextWriter writer(f);
+  writer.setChunkSize(1);
+  bool written = true;
+  for(size_t s = 0; s < sectionNames.size() && written; s++)
+  {
+    const std::string& name = sectionNames[s];
+    fprintf(f, "\n%s\n%llu\n", name.c_str(), static_cast<unsigned long long>(sectionCounts[s]));
+    written = writer.write(files.size(), [&files, &name](std::string& buffer, size_t start, size_t end) {
+      for(size_t i = start; i < end; i++)
+      {
+        files[i]->format(name, buffer);
+      }
+    });
+  }
+  fprintf(f, "\nendmesh\n");
+
+  if(fclose(f) != 0 || !written)
+  {
+    m_ErrorMessage = QObject::tr("Error writing merged mesh file: %1").arg(outputFile);
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString NetgenVolMerger::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QStringList NetgenVolMerger::getDroppedSections() const
+{
+  return m_DroppedSections;
+}
+
+} // namespace SimulationIO
@@ -0,0 +1,107 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SimulationIO/SimulationIODLLExport.h"
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The NetgenVolMerger class merges Netgen .vol mesh files into a single .vol file without running Netgen.
+ * The files are read (memory mapped, scanned in parallel when SIMPLib is built with TBB) and their sections are
+ * concatenated in one pass, with the numbers of each file shifted past the numbers used by the files before it:
+ * point indices by the number of points, material (domain) numbers by the largest material number, surface numbers
+ * by the largest surface number and edge numbers by the largest edge number. Merging per-feature meshes in feature
+ * order therefore gives the volume elements of feature i the material number i, as "netgen -mergefile" does.
+ *
+ * The sections mesh3d, dimension, geomtype, surfaceelements (also the gi and uv variants), volumeelements,
+ * edgesegments (also gi and gi2), points, materials, face_colours and endmesh are understood. Other sections are
+ * left out of the merged file and reported by getDroppedSections().
+ */
+class SimulationIO_EXPORT NetgenVolMerger
+{
+public:
+  NetgenVolMerger();
+  ~NetgenVolMerger();
+
+  /**
+   * @brief merge Merges the input files, in order, into outputFile
+   * @param inputFiles
+   * @param outputFile Overwritten if it exists; may not be one of the input files
+   * @return false on error, see getErrorMessage()
+   */
+  bool merge(const QStringList& inputFiles, const QString& outputFile);
+
+  /**
+   * @brief getErrorMessage Returns why the last merge failed
+   */
+  QString getErrorMessage() const;
+
+  /**
+   * @brief getDroppedSections Returns the names of the sections the last merge could not carry over
+   */
+  QStringList getDroppedSections() const;
+
+  /**
+   * @brief The OffsetKind enum says which numbering a column of a section record refers to
+   */
+  enum class OffsetKind : int
+  {
+    None,
+    Point,
+    Surface,
+    Domain,
+    Edge
+  };
+
+  /**
+   * @brief The SectionKind enum lists the sections whose records are understood
+   */
+  enum class SectionKind : int
+  {
+    Unknown,
+    SurfaceElements,
+    VolumeElements,
+    EdgeSegments,
+    EdgeSegmentsGI2,
+    Points,
+    Materials,
+    FaceColours
+  };
+
+  /**
+   * @brief GetSectionKind Returns the kind of the section with the given keyword
+   */
+  static SectionKind GetSectionKind(const QString& keyword);
+
+  /**
+   * @brief GetColumnKind Returns which numbering column refers to in a record of a section
+   * @param kind
+   * @param column Zero based column index
+   * @param numPoints For element records: the number of points of the element (the "np" column)
+   */
+  static OffsetKind GetColumnKind(SectionKind kind, size_t column, int64_t numPoints);
+
+  struct VolFile;
+
+private:
+  QString m_ErrorMessage;
+  QStringList m_DroppedSections;
+
+public:
+  NetgenVolMerger(const NetgenVolMerger&) = delete;            // Copy Constructor Not Implemented
+  NetgenVolMerger(NetgenVolMerger&&) = delete;                 // Move Constructor Not Implemented
+  NetgenVolMerger& operator=(const NetgenVolMerger&) = delete; // Copy Assignment Not Implemented
+  NetgenVolMerger& operator=(NetgenVolMerger&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
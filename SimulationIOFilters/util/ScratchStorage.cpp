@@ -0,0 +1,76 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#include "ScratchStorage.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QObject>
+
+namespace SimulationIO
+{
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScratchStorage::ScratchStorage(const QString& directory)
+: m_Directory(directory)
+{
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+ScratchStorage::~ScratchStorage() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+std::shared_ptr<QTemporaryFile> ScratchStorage::allocate(size_t bytes, void*& data)
+{
+  data = nullptr;
+  std::shared_ptr<QTemporaryFile> file(new QTemporaryFile(QDir(m_Directory).absoluteFilePath("SimulationIO_XXXXXX.scratch")));
+  if(!file->open())
+  {
+    m_ErrorMessage = QObject::tr("Could not create a scratch file in '%1': %2").arg(m_Directory).arg(file->errorString());
+    return std::shared_ptr<QTemporaryFile>();
+  }
+
+  // Growing the file leaves it sparse on most file systems; disk space is only used for pages that are written
+  qint64 size = static_cast<qint64>(bytes);
+  if(!file->resize(size))
+  {
+    m_ErrorMessage = QObject::tr("Could not grow scratch file '%1' to %2 bytes: %3").arg(file->fileName()).arg(size).arg(file->errorString());
+    return std::shared_ptr<QTemporaryFile>();
+  }
+
+  // The mapping stays valid after the storage is gone; QFileDevice unmaps it when the file is destroyed
+  uchar* map = file->map(0, size);
+  if(nullptr == map)
+  {
+    m_ErrorMessage = QObject::tr("Could not map scratch file '%1' of %2 bytes: %3").arg(file->fileName()).arg(size).arg(file->errorString());
+    return std::shared_ptr<QTemporaryFile>();
+  }
+
+  m_NumBytes += bytes;
+  data = map;
+  return file;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t ScratchStorage::getNumberOfBytes() const
+{
+  return m_NumBytes;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString ScratchStorage::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+} // namespace SimulationIO
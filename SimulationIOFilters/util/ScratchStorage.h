@@ -0,0 +1,95 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QString>
+#include <QtCore/QTemporaryFile>
+
+#include "SIMPLib/SIMPLib.h"
+#include "SIMPLib/DataArrays/DataArray.hpp"
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The ScratchStorage class hands out memory that is backed by temporary files instead of RAM, so arrays
+ * larger than the physical memory can be filled and used. Every allocation is a scratch file in the storage
+ * directory, grown to the requested size (zero filled) and mapped writable; the operating system writes pages out
+ * to the file and drops them when memory runs low, instead of swapping. Every allocation owns its file: the file is
+ * unmapped and removed when the last reference to it (or to the array created on it) is released, independent of
+ * the storage, which may be destroyed first.
+ */
+class ScratchStorage
+{
+public:
+  /**
+   * @param directory Directory the scratch files are created in
+   */
+  explicit ScratchStorage(const QString& directory);
+  ~ScratchStorage();
+
+  /**
+   * @brief allocate Creates a scratch file of bytes zero filled, file backed memory
+   * @param bytes Must be greater than 0
+   * @param data Set to the mapped memory, which stays valid as long as the returned file exists
+   * @return A null pointer on error, see getErrorMessage()
+   */
+  std::shared_ptr<QTemporaryFile> allocate(size_t bytes, void*& data);
+
+  /**
+   * @brief createArray Creates a zero filled array whose values live in a scratch file. The array owns the file:
+   * all copies of the returned pointer share it, and the file is removed when the last of them is released.
+   * @return A null pointer on error, see getErrorMessage()
+   */
+  template <typename T>
+  typename DataArray<T>::Pointer createArray(size_t numTuples, const std::vector<size_t>& cDims, const QString& name)
+  {
+    size_t numValues = numTuples;
+    for(size_t dim : cDims)
+    {
+      numValues *= dim;
+    }
+    void* data = nullptr;
+    std::shared_ptr<QTemporaryFile> file = allocate(numValues * sizeof(T), data);
+    if(nullptr == file.get())
+    {
+      return DataArray<T>::NullPointer();
+    }
+    typename DataArray<T>::Pointer array = DataArray<T>::WrapPointer(static_cast<T*>(data), numTuples, cDims, name, false);
+    // The deleter of the returned pointer holds the file, so the mapping lives exactly as long as the array
+    DataArray<T>* arrayPtr = array.get();
+    return typename DataArray<T>::Pointer(arrayPtr, [array, file](DataArray<T>*) mutable {
+      array.reset();
+      file.reset();
+    });
+  }
+
+  /**
+   * @brief getNumberOfBytes Returns the total size of all scratch files created by this storage
+   */
+  size_t getNumberOfBytes() const;
+
+  /**
+   * @brief getErrorMessage Returns why the last allocation failed
+   */
+  QString getErrorMessage() const;
+
+private:
+  QString m_Directory;
+  size_t m_NumBytes = 0;
+  QString m_ErrorMessage;
+
+public:
+  ScratchStorage(const ScratchStorage&) = delete;            // Copy Constructor Not Implemented
+  ScratchStorage(ScratchStorage&&) = delete;                 // Move Constructor Not Implemented
+  ScratchStorage& operator=(const ScratchStorage&) = delete; // Copy Assignment Not Implemented
+  ScratchStorage& operator=(ScratchStorage&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
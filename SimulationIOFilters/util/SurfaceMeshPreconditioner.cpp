@@ -0,0 +1,725 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#include "SurfaceMeshPreconditioner.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace SimulationIO
+{
+namespace
+{
+/**
+ * @brief Weight of the planes that hold the curves between boundary patches in place, relative to the planes of the faces
+ */
+const double k_FeatureWeight = 10.0;
+
+/**
+ * @brief A collapse may not create a triangle of lower quality (see TriangleQuality) than this, unless the triangle was already worse
+ */
+const double k_MinTriangleQuality = 0.1;
+
+/**
+ * @brief CellKey Integer coordinates of a cell of the welding hash (or the bit patterns of the coordinates when
+ * only identical vertices are welded)
+ */
+struct CellKey
+{
+  int64_t x;
+  int64_t y;
+  int64_t z;
+
+  bool operator==(const CellKey& other) const
+  {
+    return x == other.x && y == other.y && z == other.z;
+  }
+};
+
+struct CellKeyHash
+{
+  size_t operator()(const CellKey& key) const
+  {
+    return static_cast<size_t>(key.x * 73856093) ^ static_cast<size_t>(key.y * 19349663) ^ static_cast<size_t>(key.z * 83492791);
+  }
+};
+
+/**
+ * @brief TriangleKey The vertices of a triangle in increasing order, to find repeated triangles
+ */
+struct TriangleKey
+{
+  MeshIndexType v[3];
+
+  bool operator==(const TriangleKey& other) const
+  {
+    return v[0] == other.v[0] && v[1] == other.v[1] && v[2] == other.v[2];
+  }
+};
+
+struct TriangleKeyHash
+{
+  size_t operator()(const TriangleKey& key) const
+  {
+    std::hash<MeshIndexType> hash;
+    return hash(key.v[0]) ^ (hash(key.v[1]) * 31) ^ (hash(key.v[2]) * 1009);
+  }
+};
+
+/**
+ * @brief Quadric Symmetric 4x4 matrix of the squared distance to a set of weighted planes, stored as its upper
+ * triangle (xx xy xz xw yy yz yw zz zw ww)
+ */
+struct Quadric
+{
+  double a[10] = {0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0};
+
+  void addPlane(const double n[3], double d, double weight)
+  {
+    a[0] += weight * n[0] * n[0];
+    a[1] += weight * n[0] * n[1];
+    a[2] += weight * n[0] * n[2];
+    a[3] += weight * n[0] * d;
+    a[4] += weight * n[1] * n[1];
+    a[5] += weight * n[1] * n[2];
+    a[6] += weight * n[1] * d;
+    a[7] += weight * n[2] * n[2];
+    a[8] += weight * n[2] * d;
+    a[9] += weight * d * d;
+  }
+
+  void add(const Quadric& other)
+  {
+    for(size_t i = 0; i < 10; i++)
+    {
+      a[i] += other.a[i];
+    }
+  }
+
+  double evaluate(const float* p) const
+  {
+    double x = p[0];
+    double y = p[1];
+    double z = p[2];
+    return a[0] * x * x + 2.0 * a[1] * x * y + 2.0 * a[2] * x * z + 2.0 * a[3] * x + a[4] * y * y + 2.0 * a[5] * y * z + 2.0 * a[6] * y + a[7] * z * z + 2.0 * a[8] * z + a[9];
+  }
+};
+
+/**
+ * @brief Collapse Candidate half-edge collapse: vertex from is removed and its faces are moved onto vertex to. The
+ * versions tell whether the neighborhood of the vertices changed since the cost was computed.
+ */
+struct Collapse
+{
+  double cost;
+  size_t from;
+  size_t to;
+  uint32_t fromVersion;
+  uint32_t toVersion;
+
+  bool operator>(const Collapse& other) const
+  {
+    return cost > other.cost;
+  }
+};
+
+/**
+ * @brief Edge An edge around a vertex: the other vertex, how many faces share the edge, and whether it
+ * lies on a curve between boundary patches (anything but two faces of the same patch)
+ */
+struct Edge
+{
+  size_t other;
+  size_t numFaces;
+  bool feature;
+};
+
+void Cross(const float* p0, const float* p1, const float* p2, double n[3])
+{
+  double a[3] = {static_cast<double>(p1[0]) - p0[0], static_cast<double>(p1[1]) - p0[1], static_cast<double>(p1[2]) - p0[2]};
+  double b[3] = {static_cast<double>(p2[0]) - p0[0], static_cast<double>(p2[1]) - p0[1], static_cast<double>(p2[2]) - p0[2]};
+  n[0] = a[1] * b[2] - a[2] * b[1];
+  n[1] = a[2] * b[0] - a[0] * b[2];
+  n[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+double Distance2(const float* p, const float* q)
+{
+  double dx = static_cast<double>(p[0]) - q[0];
+  double dy = static_cast<double>(p[1]) - q[1];
+  double dz = static_cast<double>(p[2]) - q[2];
+  return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * @brief TriangleQuality Returns 4 sqrt(3) area / (sum of squared edge lengths): 1 for an equilateral triangle, 0 for a degenerate one
+ */
+double TriangleQuality(const float* p0, const float* p1, const float* p2)
+{
+  double n[3];
+  Cross(p0, p1, p2, n);
+  double edges = Distance2(p0, p1) + Distance2(p1, p2) + Distance2(p2, p0);
+  if(edges <= 0.0)
+  {
+    return 0.0;
+  }
+  return 2.0 * std::sqrt(3.0) * std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]) / edges;
+}
+
+/**
+ * @brief PatchKey Returns the unordered pair of labels of a face; faces with the same key belong to the same boundary patch
+ */
+uint64_t PatchKey(const int32_t* labels)
+{
+  uint32_t a = static_cast<uint32_t>(std::min(labels[0], labels[1]));
+  uint32_t b = static_cast<uint32_t>(std::max(labels[0], labels[1]));
+  return (static_cast<uint64_t>(a) << 32) | b;
+}
+} // namespace
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SurfaceMeshPreconditioner::SurfaceMeshPreconditioner() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+SurfaceMeshPreconditioner::~SurfaceMeshPreconditioner() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SurfaceMeshPreconditioner::setWeldTolerance(float tolerance)
+{
+  m_WeldTolerance = tolerance;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SurfaceMeshPreconditioner::setTargetEdgeLength(float length)
+{
+  m_TargetEdgeLength = length;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SurfaceMeshPreconditioner::run(const float* vertices, size_t numVertices, const MeshIndexType* triangles, const int32_t* faceLabels, size_t numTriangles)
+{
+  m_NumWeldedVertices = 0;
+  m_NumRemovedTriangles = 0;
+  m_NumCollapsedEdges = 0;
+
+  weldVertices(vertices, numVertices, triangles, numTriangles);
+  removeDegenerateTriangles(faceLabels, numTriangles);
+  if(m_TargetEdgeLength > 0.0f)
+  {
+    decimate();
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<float>& SurfaceMeshPreconditioner::getVertices() const
+{
+  return m_Vertices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<MeshIndexType>& SurfaceMeshPreconditioner::getTriangles() const
+{
+  return m_Triangles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+const std::vector<int32_t>& SurfaceMeshPreconditioner::getFaceLabels() const
+{
+  return m_FaceLabels;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SurfaceMeshPreconditioner::getNumberOfWeldedVertices() const
+{
+  return m_NumWeldedVertices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SurfaceMeshPreconditioner::getNumberOfRemovedTriangles() const
+{
+  return m_NumRemovedTriangles;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t SurfaceMeshPreconditioner::getNumberOfCollapsedEdges() const
+{
+  return m_NumCollapsedEdges;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SurfaceMeshPreconditioner::weldVertices(const float* vertices, size_t numVertices, const MeshIndexType* triangles, size_t numTriangles)
+{
+  // Every cell lists the welded vertices whose first input vertex fell into it. With a tolerance a vertex can
+  // be welded to a vertex of any neighboring cell; without one only identical coordinates share a cell.
+  bool exact = !(m_WeldTolerance > 0.0f);
+  double inverseCellSize = exact ? 0.0 : 1.0 / static_cast<double>(m_WeldTolerance);
+  double tolerance2 = exact ? 0.0 : static_cast<double>(m_WeldTolerance) * m_WeldTolerance;
+  int64_t reach = exact ? 0 : 1;
+
+  std::unordered_map<CellKey, std::vector<size_t>, CellKeyHash> cells;
+  cells.reserve(numVertices);
+  std::vector<MeshIndexType> remap(numVertices);
+  m_Vertices.clear();
+  m_Vertices.reserve(3 * numVertices);
+  for(size_t v = 0; v < numVertices; v++)
+  {
+    const float* p = vertices + 3 * v;
+    CellKey key = {0, 0, 0};
+    if(exact)
+    {
+      int32_t bits[3];
+      float coords[3] = {p[0] + 0.0f, p[1] + 0.0f, p[2] + 0.0f}; // -0 and +0 are the same position
+      std::memcpy(bits, coords, sizeof(bits));
+      key = {bits[0], bits[1], bits[2]};
+    }
+    else
+    {
+      key = {static_cast<int64_t>(std::floor(p[0] * inverseCellSize)), static_cast<int64_t>(std::floor(p[1] * inverseCellSize)),
+             static_cast<int64_t>(std::floor(p[2] * inverseCellSize))};
+    }
+
+    size_t found = std::numeric_limits<size_t>::max();
+    for(int64_t dx = -reach; dx <= reach && found == std::numeric_limits<size_t>::max(); dx++)
+    {
+      for(int64_t dy = -reach; dy <= reach && found == std::numeric_limits<size_t>::max(); dy++)
+      {
+        for(int64_t dz = -reach; dz <= reach && found == std::numeric_limits<size_t>::max(); dz++)
+        {
+          auto cell = cells.find({key.x + dx, key.y + dy, key.z + dz});
+          if(cell == cells.end())
+          {
+            continue;
+          }
+          for(size_t welded : cell->second)
+          {
+            if(Distance2(m_Vertices.data() + 3 * welded, p) <= tolerance2)
+            {
+              found = welded;
+              break;
+            }
+          }
+        }
+      }
+    }
+
+    if(found == std::numeric_limits<size_t>::max())
+    {
+      found = m_Vertices.size() / 3;
+      m_Vertices.insert(m_Vertices.end(), p, p + 3);
+      cells[key].push_back(found);
+    }
+    remap[v] = static_cast<MeshIndexType>(found);
+  }
+  m_NumWeldedVertices = numVertices - m_Vertices.size() / 3;
+
+  m_Triangles.resize(3 * numTriangles);
+  for(size_t i = 0; i < 3 * numTriangles; i++)
+  {
+    m_Triangles[i] = remap[triangles[i]];
+  }
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SurfaceMeshPreconditioner::removeDegenerateTriangles(const int32_t* faceLabels, size_t numTriangles)
+{
+  std::unordered_set<TriangleKey, TriangleKeyHash> seen;
+  seen.reserve(numTriangles);
+  m_FaceLabels.clear();
+  m_FaceLabels.reserve(2 * numTriangles);
+  size_t kept = 0;
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    const MeshIndexType* tri = m_Triangles.data() + 3 * t;
+    if(tri[0] == tri[1] || tri[1] == tri[2] || tri[2] == tri[0])
+    {
+      continue;
+    }
+
+    // No area, relative to the size of the triangle
+    const float* p0 = m_Vertices.data() + 3 * tri[0];
+    const float* p1 = m_Vertices.data() + 3 * tri[1];
+    const float* p2 = m_Vertices.data() + 3 * tri[2];
+    double n[3];
+    Cross(p0, p1, p2, n);
+    double longest2 = std::max({Distance2(p0, p1), Distance2(p1, p2), Distance2(p2, p0)});
+    if(n[0] * n[0] + n[1] * n[1] + n[2] * n[2] <= 1.0e-24 * longest2 * longest2)
+    {
+      continue;
+    }
+
+    TriangleKey key = {{tri[0], tri[1], tri[2]}};
+    std::sort(key.v, key.v + 3);
+    if(!seen.insert(key).second)
+    {
+      continue;
+    }
+
+    std::copy(tri, tri + 3, m_Triangles.begin() + 3 * kept);
+    m_FaceLabels.push_back(faceLabels[2 * t]);
+    m_FaceLabels.push_back(faceLabels[2 * t + 1]);
+    kept++;
+  }
+  m_Triangles.resize(3 * kept);
+  m_NumRemovedTriangles = numTriangles - kept;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+void SurfaceMeshPreconditioner::decimate()
+{
+  size_t numVertices = m_Vertices.size() / 3;
+  size_t numTriangles = m_Triangles.size() / 3;
+  const double maxLength2 = static_cast<double>(m_TargetEdgeLength) * m_TargetEdgeLength;
+  const float* positions = m_Vertices.data();
+  MeshIndexType* tris = m_Triangles.data();
+
+  std::vector<uint64_t> patches(numTriangles);
+  std::vector<char> faceAlive(numTriangles, 1);
+  std::vector<char> vertexAlive(numVertices, 1);
+  std::vector<uint32_t> versions(numVertices, 0);
+  std::vector<std::vector<size_t>> vertexFaces(numVertices);
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    patches[t] = PatchKey(m_FaceLabels.data() + 2 * t);
+    for(size_t c = 0; c < 3; c++)
+    {
+      vertexFaces[tris[3 * t + c]].push_back(t);
+    }
+  }
+
+  // The edges around a vertex, sorted by the other vertex
+  auto edgesOf = [&](size_t u, std::vector<Edge>& edges) {
+    std::vector<std::pair<size_t, size_t>> ends; // other vertex, face
+    for(size_t t : vertexFaces[u])
+    {
+      if(faceAlive[t] == 0)
+      {
+        continue;
+      }
+      for(size_t c = 0; c < 3; c++)
+      {
+        if(tris[3 * t + c] != u)
+        {
+          ends.emplace_back(tris[3 * t + c], t);
+        }
+      }
+    }
+    std::sort(ends.begin(), ends.end());
+    edges.clear();
+    for(size_t i = 0; i < ends.size();)
+    {
+      size_t j = i;
+      bool samePatch = true;
+      while(j < ends.size() && ends[j].first == ends[i].first)
+      {
+        samePatch = samePatch && patches[ends[j].second] == patches[ends[i].second];
+        j++;
+      }
+      edges.push_back({ends[i].first, j - i, !(j - i == 2 && samePatch)});
+      i = j;
+    }
+  };
+
+  // Quadrics: the plane of every face, and along the curves between patches planes through the edge and
+  // perpendicular to its faces, so that collapses along a curve keep its shape
+  std::vector<Quadric> quadrics(numVertices);
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    const MeshIndexType* tri = tris + 3 * t;
+    double n[3];
+    Cross(positions + 3 * tri[0], positions + 3 * tri[1], positions + 3 * tri[2], n);
+    double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+    if(length <= 0.0)
+    {
+      continue;
+    }
+    n[0] /= length;
+    n[1] /= length;
+    n[2] /= length;
+    const float* p0 = positions + 3 * tri[0];
+    double d = -(n[0] * p0[0] + n[1] * p0[1] + n[2] * p0[2]);
+    for(size_t c = 0; c < 3; c++)
+    {
+      quadrics[tri[c]].addPlane(n, d, 0.5 * length);
+    }
+  }
+  std::vector<Edge> edges;
+  for(size_t u = 0; u < numVertices; u++)
+  {
+    edgesOf(u, edges);
+    for(const Edge& edge : edges)
+    {
+      if(!edge.feature || edge.other < u)
+      {
+        continue;
+      }
+      const float* pu = positions + 3 * u;
+      const float* pw = positions + 3 * edge.other;
+      double e[3] = {static_cast<double>(pw[0]) - pu[0], static_cast<double>(pw[1]) - pu[1], static_cast<double>(pw[2]) - pu[2]};
+      double length2 = e[0] * e[0] + e[1] * e[1] + e[2] * e[2];
+      for(size_t t : vertexFaces[u])
+      {
+        const MeshIndexType* tri = tris + 3 * t;
+        if(tri[0] != edge.other && tri[1] != edge.other && tri[2] != edge.other)
+        {
+          continue;
+        }
+        double n[3];
+        Cross(positions + 3 * tri[0], positions + 3 * tri[1], positions + 3 * tri[2], n);
+        double m[3] = {e[1] * n[2] - e[2] * n[1], e[2] * n[0] - e[0] * n[2], e[0] * n[1] - e[1] * n[0]};
+        double length = std::sqrt(m[0] * m[0] + m[1] * m[1] + m[2] * m[2]);
+        if(length <= 0.0)
+        {
+          continue;
+        }
+        m[0] /= length;
+        m[1] /= length;
+        m[2] /= length;
+        double d = -(m[0] * pu[0] + m[1] * pu[1] + m[2] * pu[2]);
+        quadrics[u].addPlane(m, d, k_FeatureWeight * length2);
+        quadrics[edge.other].addPlane(m, d, k_FeatureWeight * length2);
+      }
+    }
+  }
+
+  std::priority_queue<Collapse, std::vector<Collapse>, std::greater<Collapse>> queue;
+  auto push = [&](size_t from, size_t to) {
+    Quadric q = quadrics[from];
+    q.add(quadrics[to]);
+    queue.push({q.evaluate(positions + 3 * to), from, to, versions[from], versions[to]});
+  };
+  for(size_t u = 0; u < numVertices; u++)
+  {
+    edgesOf(u, edges);
+    for(const Edge& edge : edges)
+    {
+      push(u, edge.other);
+    }
+  }
+
+  std::vector<Edge> edgesTo;
+  auto canCollapse = [&](size_t u, size_t v) {
+    edgesOf(u, edges);
+    const Edge* uv = nullptr;
+    size_t numFeatureEdges = 0;
+    for(const Edge& edge : edges)
+    {
+      numFeatureEdges += edge.feature ? 1 : 0;
+      if(edge.other == v)
+      {
+        uv = &edge;
+      }
+    }
+    // Vertices inside a patch may go anywhere, vertices on a curve only along it, the ends of curves nowhere
+    if(nullptr == uv || (numFeatureEdges != 0 && (numFeatureEdges != 2 || !uv->feature)))
+    {
+      return false;
+    }
+
+    for(const Edge& edge : edges)
+    {
+      if(edge.other != v && Distance2(positions + 3 * v, positions + 3 * edge.other) > maxLength2)
+      {
+        return false;
+      }
+    }
+
+    // Link condition: u and v may only share the neighbors opposite to their common edge
+    edgesOf(v, edgesTo);
+    size_t common = 0;
+    for(size_t i = 0, j = 0; i < edges.size() && j < edgesTo.size();)
+    {
+      if(edges[i].other < edgesTo[j].other)
+      {
+        i++;
+      }
+      else if(edgesTo[j].other < edges[i].other)
+      {
+        j++;
+      }
+      else
+      {
+        common++;
+        i++;
+        j++;
+      }
+    }
+    if(common != uv->numFaces)
+    {
+      return false;
+    }
+
+    // The faces that stay may not flip, become much worse or land on a face of v (a closed patch that is
+    // down to a tetrahedron)
+    for(size_t t : vertexFaces[u])
+    {
+      const MeshIndexType* tri = tris + 3 * t;
+      if(faceAlive[t] == 0 || tri[0] == v || tri[1] == v || tri[2] == v)
+      {
+        continue;
+      }
+      for(size_t s : vertexFaces[v])
+      {
+        const MeshIndexType* other = tris + 3 * s;
+        size_t shared = 0;
+        for(size_t c = 0; c < 3; c++)
+        {
+          shared += (tri[c] != u && (other[0] == tri[c] || other[1] == tri[c] || other[2] == tri[c])) ? 1 : 0;
+        }
+        if(faceAlive[s] != 0 && shared == 2)
+        {
+          return false;
+        }
+      }
+      const float* corners[3];
+      const float* moved[3];
+      for(size_t c = 0; c < 3; c++)
+      {
+        corners[c] = positions + 3 * tri[c];
+        moved[c] = (tri[c] == u) ? positions + 3 * v : corners[c];
+      }
+      double before[3];
+      double after[3];
+      Cross(corners[0], corners[1], corners[2], before);
+      Cross(moved[0], moved[1], moved[2], after);
+      if(before[0] * after[0] + before[1] * after[1] + before[2] * after[2] <= 0.0)
+      {
+        return false;
+      }
+      double quality = TriangleQuality(moved[0], moved[1], moved[2]);
+      if(quality < k_MinTriangleQuality && quality < TriangleQuality(corners[0], corners[1], corners[2]))
+      {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  std::vector<size_t> touched;
+  while(!queue.empty())
+  {
+    Collapse candidate = queue.top();
+    queue.pop();
+    size_t u = candidate.from;
+    size_t v = candidate.to;
+    if(vertexAlive[u] == 0 || vertexAlive[v] == 0 || candidate.fromVersion != versions[u] || candidate.toVersion != versions[v] || !canCollapse(u, v))
+    {
+      continue;
+    }
+
+    // The faces on the edge disappear, the others move from u to v
+    for(size_t t : vertexFaces[u])
+    {
+      if(faceAlive[t] == 0)
+      {
+        continue;
+      }
+      MeshIndexType* tri = tris + 3 * t;
+      if(tri[0] == v || tri[1] == v || tri[2] == v)
+      {
+        faceAlive[t] = 0;
+        continue;
+      }
+      for(size_t c = 0; c < 3; c++)
+      {
+        if(tri[c] == u)
+        {
+          tri[c] = static_cast<MeshIndexType>(v);
+        }
+      }
+      vertexFaces[v].push_back(t);
+    }
+    vertexAlive[u] = 0;
+    std::vector<size_t>().swap(vertexFaces[u]);
+    quadrics[v].add(quadrics[u]);
+    m_NumCollapsedEdges++;
+
+    // Every vertex around v has a new neighborhood: drop dead faces from its list and queue its edges again
+    edgesOf(v, edges);
+    touched.clear();
+    touched.push_back(v);
+    for(const Edge& edge : edges)
+    {
+      touched.push_back(edge.other);
+    }
+    for(size_t w : touched)
+    {
+      std::vector<size_t>& faces = vertexFaces[w];
+      faces.erase(std::remove_if(faces.begin(), faces.end(), [&faceAlive](size_t t) { return faceAlive[t] == 0; }), faces.end());
+      versions[w]++;
+    }
+    for(size_t w : touched)
+    {
+      edgesOf(w, edgesTo);
+      for(const Edge& edge : edgesTo)
+      {
+        push(w, edge.other);
+        push(edge.other, w);
+      }
+    }
+  }
+
+  // Compact the vertices and faces that are left
+  std::vector<MeshIndexType> remap(numVertices, std::numeric_limits<MeshIndexType>::max());
+  std::vector<float> vertices;
+  std::vector<MeshIndexType> triangles;
+  std::vector<int32_t> faceLabels;
+  for(size_t t = 0; t < numTriangles; t++)
+  {
+    if(faceAlive[t] == 0)
+    {
+      continue;
+    }
+    for(size_t c = 0; c < 3; c++)
+    {
+      MeshIndexType& index = remap[tris[3 * t + c]];
+      if(index == std::numeric_limits<MeshIndexType>::max())
+      {
+        index = static_cast<MeshIndexType>(vertices.size() / 3);
+        vertices.insert(vertices.end(), positions + 3 * tris[3 * t + c], positions + 3 * tris[3 * t + c] + 3);
+      }
+      triangles.push_back(index);
+    }
+    faceLabels.push_back(m_FaceLabels[2 * t]);
+    faceLabels.push_back(m_FaceLabels[2 * t + 1]);
+  }
+  m_Vertices.swap(vertices);
+  m_Triangles.swap(triangles);
+  m_FaceLabels.swap(faceLabels);
+}
+
+} // namespace SimulationIO
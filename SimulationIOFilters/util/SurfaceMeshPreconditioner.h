@@ -0,0 +1,102 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "SimulationIO/SimulationIODLLExport.h"
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The SurfaceMeshPreconditioner class cleans up and coarsens a labeled triangle surface mesh (the grain
+ * boundaries of a voxel surface mesh) before it is handed to a volume mesher. It runs three stages:
+ *
+ * 1. Vertices closer than the weld tolerance are merged, using a spatial hash of cells of that size. A tolerance
+ *    of 0 only merges vertices with identical coordinates.
+ * 2. Triangles that have lost a corner to welding or have no area are removed, as are repeated triangles.
+ * 3. If a target edge length is set, edges are collapsed in order of their quadric error (half-edge collapses,
+ *    so vertices stay at input positions) until no collapse is possible without making an edge longer than the
+ *    target. A boundary patch is the set of faces with the same pair of labels. Vertices inside a patch can be
+ *    removed; vertices on the curves where patches meet can only slide along the curve; vertices where curves
+ *    meet are kept. Collapses that would change the topology or flip a triangle are skipped, so every grain
+ *    keeps its boundary patches.
+ *
+ * The triangles keep their labels and winding.
+ */
+class SimulationIO_EXPORT SurfaceMeshPreconditioner
+{
+public:
+  SurfaceMeshPreconditioner();
+  ~SurfaceMeshPreconditioner();
+
+  /**
+   * @brief setWeldTolerance Sets the distance below which vertices are merged (default 0)
+   */
+  void setWeldTolerance(float tolerance);
+
+  /**
+   * @brief setTargetEdgeLength Sets the edge length decimation coarsens to; 0 (default) turns decimation off
+   */
+  void setTargetEdgeLength(float length);
+
+  /**
+   * @brief run Preconditions a surface mesh; the result replaces the result of the previous run
+   * @param vertices 3 coordinates per vertex
+   * @param numVertices
+   * @param triangles 3 vertex indices per triangle
+   * @param faceLabels 2 labels per triangle
+   * @param numTriangles
+   */
+  void run(const float* vertices, size_t numVertices, const MeshIndexType* triangles, const int32_t* faceLabels, size_t numTriangles);
+
+  /**
+   * @brief getVertices Returns 3 coordinates for each vertex of the result
+   */
+  const std::vector<float>& getVertices() const;
+
+  /**
+   * @brief getTriangles Returns 3 vertex indices for each triangle of the result
+   */
+  const std::vector<MeshIndexType>& getTriangles() const;
+
+  /**
+   * @brief getFaceLabels Returns the 2 labels of each triangle of the result
+   */
+  const std::vector<int32_t>& getFaceLabels() const;
+
+  size_t getNumberOfWeldedVertices() const;
+  size_t getNumberOfRemovedTriangles() const;
+  size_t getNumberOfCollapsedEdges() const;
+
+private:
+  float m_WeldTolerance = 0.0f;
+  float m_TargetEdgeLength = 0.0f;
+
+  std::vector<float> m_Vertices;
+  std::vector<MeshIndexType> m_Triangles;
+  std::vector<int32_t> m_FaceLabels;
+
+  size_t m_NumWeldedVertices = 0;
+  size_t m_NumRemovedTriangles = 0;
+  size_t m_NumCollapsedEdges = 0;
+
+  void weldVertices(const float* vertices, size_t numVertices, const MeshIndexType* triangles, size_t numTriangles);
+  void removeDegenerateTriangles(const int32_t* faceLabels, size_t numTriangles);
+  void decimate();
+
+public:
+  SurfaceMeshPreconditioner(const SurfaceMeshPreconditioner&) = delete;            // Copy Constructor Not Implemented
+  SurfaceMeshPreconditioner(SurfaceMeshPreconditioner&&) = delete;                 // Move Constructor Not Implemented
+  SurfaceMeshPreconditioner& operator=(const SurfaceMeshPreconditioner&) = delete; // Copy Assignment Not Implemented
+  SurfaceMeshPreconditioner& operator=(SurfaceMeshPreconditioner&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
@@ -0,0 +1,189 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace SimulationIO
+{
+/**
+ * @brief The TextFormatting namespace holds allocation free number-to-text routines used by the
+ * text exporters of this plugin. Every function writes into a caller supplied buffer and returns a
+ * pointer one past the last character written; no terminating null character is written.
+ */
+namespace TextFormatting
+{
+/**
+ * @brief Maximum number of characters any of the routines below writes for a single value.
+ */
+const size_t k_MaxCharsPerValue = 64;
+
+/**
+ * @brief DigitPairs Returns the lookup table "00", "01", ... "99" used to emit two digits at a time
+ */
+inline const char* DigitPairs()
+{
+  static const char k_Pairs[] = "00010203040506070809"
+                                "10111213141516171819"
+                                "20212223242526272829"
+                                "30313233343536373839"
+                                "40414243444546474849"
+                                "50515253545556575859"
+                                "60616263646566676869"
+                                "70717273747576777879"
+                                "80818283848586878889"
+                                "90919293949596979899";
+  return k_Pairs;
+}
+
+/**
+ * @brief FormatUInt Writes value in decimal notation (same output as "%llu")
+ * @param out Destination buffer with room for at least 20 characters
+ * @param value
+ * @return One past the last character written
+ */
+inline char* FormatUInt(char* out, uint64_t value)
+{
+  char tmp[24];
+  char* p = tmp + sizeof(tmp);
+  const char* pairs = DigitPairs();
+  while(value >= 100)
+  {
+    uint64_t idx = (value % 100) * 2;
+    value /= 100;
+    *--p = pairs[idx + 1];
+    *--p = pairs[idx];
+  }
+  if(value >= 10)
+  {
+    uint64_t idx = value * 2;
+    *--p = pairs[idx + 1];
+    *--p = pairs[idx];
+  }
+  else
+  {
+    *--p = static_cast<char>('0' + value);
+  }
+  size_t len = static_cast<size_t>(tmp + sizeof(tmp) - p);
+  std::memcpy(out, p, len);
+  return out + len;
+}
+
+/**
+ * @brief FormatInt Writes value in decimal notation (same output as "%lld")
+ * @param out Destination buffer with room for at least 21 characters
+ * @param value
+ * @return One past the last character written
+ */
+inline char* FormatInt(char* out, int64_t value)
+{
+  uint64_t magnitude = static_cast<uint64_t>(value);
+  if(value < 0)
+  {
+    *out++ = '-';
+    magnitude = ~magnitude + 1;
+  }
+  return FormatUInt(out, magnitude);
+}
+
+/**
+ * @brief FormatPaddedInt Writes value right aligned in a field of the given width (same output as "%10d" for width 10)
+ * @param out Destination buffer with room for at least max(width, 21) characters
+ * @param value
+ * @param width
+ * @return One past the last character written
+ */
+inline char* FormatPaddedInt(char* out, int64_t value, int width)
+{
+  char tmp[24];
+  char* end = FormatInt(tmp, value);
+  int len = static_cast<int>(end - tmp);
+  for(int i = len; i < width; i++)
+  {
+    *out++ = ' ';
+  }
+  std::memcpy(out, tmp, static_cast<size_t>(len));
+  return out + len;
+}
+
+/**
+ * @brief FormatFixed Writes value with a fixed number of decimals (same output as "%.6f" for a precision of 6).
+ * The result is identical to printf for any float input and precision <= 9 because the scaling is exact in double
+ * precision and the rounding uses the default round-half-to-even mode. Very large values, NaN and Inf fall back to snprintf.
+ * @param out Destination buffer with room for at least k_MaxCharsPerValue characters
+ * @param value
+ * @param precision Number of decimals, [0, 9]
+ * @return One past the last character written
+ */
+inline char* FormatFixed(char* out, double value, int precision)
+{
+  static const uint64_t k_Pow10[] = {1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL};
+  if(precision < 0 || precision > 9 || !std::isfinite(value) || std::fabs(value) >= 1.0e9)
+  {
+    // Anything beyond the float range would not fit the buffer in fixed notation
+    const char* format = (std::fabs(value) < 1.0e40) ? "%.*f" : "%.*e";
+    int n = std::snprintf(out, k_MaxCharsPerValue, format, precision, value);
+    return out + n;
+  }
+
+  if(std::signbit(value))
+  {
+    *out++ = '-';
+    value = -value;
+  }
+  uint64_t scale = k_Pow10[precision];
+  uint64_t scaled = static_cast<uint64_t>(std::nearbyint(value * static_cast<double>(scale)));
+  out = FormatUInt(out, scaled / scale);
+  if(precision > 0)
+  {
+    *out++ = '.';
+    uint64_t frac = scaled % scale;
+    for(int i = precision - 1; i >= 0; i--)
+    {
+      out[i] = static_cast<char>('0' + frac % 10);
+      frac /= 10;
+    }
+    out += precision;
+  }
+  return out;
+}
+
+/**
+ * @brief FormatRoundTrip Writes the shortest decimal representation of value that reads back as exactly the same float
+ * @param out Destination buffer with room for at least k_MaxCharsPerValue characters
+ * @param value
+ * @return One past the last character written
+ */
+inline char* FormatRoundTrip(char* out, float value)
+{
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  return std::to_chars(out, out + k_MaxCharsPerValue, value).ptr;
+#else
+  for(int digits = 6; digits < 9; digits++)
+  {
+    int n = std::snprintf(out, k_MaxCharsPerValue, "%.*g", digits, static_cast<double>(value));
+    if(std::strtof(out, nullptr) == value)
+    {
+      return out + n;
+    }
+  }
+  // 9 significant digits always round trip a 32 bit float
+  int n = std::snprintf(out, k_MaxCharsPerValue, "%.9g", static_cast<double>(value));
+  return out + n;
+#endif
+}
+
+} // namespace TextFormatting
+} // namespace SimulationIO
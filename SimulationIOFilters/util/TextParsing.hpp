@@ -0,0 +1,206 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+#if defined(__has_include)
+#if __has_include(<charconv>)
+#include <charconv>
+#endif
+#endif
+
+namespace SimulationIO
+{
+/**
+ * @brief The TextParsing namespace holds the text-to-number routines used by the readers of this plugin
+ * for the mesh files written by external packages. They work on a [p, end) character range (typically a
+ * memory mapped file) that does not have to be null terminated. Numbers are separated by blanks (space,
+ * tab, carriage return); the parsers never move past a line feed.
+ */
+namespace TextParsing
+{
+/**
+ * @brief Longest token the floating point parser accepts
+ */
+const size_t k_MaxCharsPerValue = 64;
+
+inline bool IsBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r';
+}
+
+/**
+ * @brief SkipBlanks Returns the first character at or after p that is not a blank
+ */
+inline const char* SkipBlanks(const char* p, const char* end)
+{
+  while(p < end && IsBlank(*p))
+  {
+    ++p;
+  }
+  return p;
+}
+
+/**
+ * @brief NextLine Returns the first character of the line after the one that contains p, or end
+ */
+inline const char* NextLine(const char* p, const char* end)
+{
+  if(p >= end)
+  {
+    return end;
+  }
+  const char* lf = static_cast<const char*>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+  return (nullptr == lf) ? end : lf + 1;
+}
+
+/**
+ * @brief IsEndOfLine Returns true if only blanks or a comment are left on the line that contains p
+ * @param p
+ * @param end
+ * @param comment Character that starts a comment, or 0 if the format has no comments
+ */
+inline bool IsEndOfLine(const char* p, const char* end, char comment = '#')
+{
+  p = SkipBlanks(p, end);
+  return p == end || *p == '\n' || (comment != 0 && *p == comment);
+}
+
+/**
+ * @brief SkipEmptyLines Returns the start of the first line at or after p that is not blank or a comment, or end
+ */
+inline const char* SkipEmptyLines(const char* p, const char* end, char comment = '#')
+{
+  while(p < end && IsEndOfLine(p, end, comment))
+  {
+    p = NextLine(p, end);
+  }
+  return p;
+}
+
+/**
+ * @brief TokenEnd Returns the end of the blank separated token that starts at p
+ */
+inline const char* TokenEnd(const char* p, const char* end)
+{
+  while(p < end && !IsBlank(*p) && *p != '\n')
+  {
+    ++p;
+  }
+  return p;
+}
+
+/**
+ * @brief ParseInt Reads a decimal integer with an optional sign, skipping leading blanks
+ * @param p Advanced past the number on success
+ * @param end
+ * @param value
+ * @return false if there is no integer at p
+ */
+inline bool ParseInt(const char*& p, const char* end, int64_t& value)
+{
+  const char* s = SkipBlanks(p, end);
+  bool negative = false;
+  if(s < end && (*s == '-' || *s == '+'))
+  {
+    negative = (*s == '-');
+    ++s;
+  }
+  if(s == end || *s < '0' || *s > '9')
+  {
+    return false;
+  }
+  int64_t v = 0;
+  while(s < end && *s >= '0' && *s <= '9')
+  {
+    v = v * 10 + (*s - '0');
+    ++s;
+  }
+  value = negative ? -v : v;
+  p = s;
+  return true;
+}
+
+/**
+ * @brief ParseDouble Reads a floating point number (any format strtod accepts), skipping leading blanks
+ * @param p Advanced past the number on success
+ * @param end
+ * @param value
+ * @return false if there is no number at p
+ */
+inline bool ParseDouble(const char*& p, const char* end, double& value)
+{
+  const char* s = SkipBlanks(p, end);
+  const char* tokenEnd = s;
+  while(tokenEnd < end && !IsBlank(*tokenEnd) && *tokenEnd != '\n')
+  {
+    ++tokenEnd;
+  }
+  if(tokenEnd == s)
+  {
+    return false;
+  }
+  if(*s == '+')
+  {
+    ++s;
+  }
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+  std::from_chars_result result = std::from_chars(s, tokenEnd, value);
+  if(result.ec != std::errc() || result.ptr != tokenEnd)
+  {
+    return false;
+  }
+#else
+  size_t length = static_cast<size_t>(tokenEnd - s);
+  if(length > k_MaxCharsPerValue)
+  {
+    return false;
+  }
+  char token[k_MaxCharsPerValue + 1];
+  std::memcpy(token, s, length);
+  token[length] = '\0';
+  char* parsedEnd = nullptr;
+  value = std::strtod(token, &parsedEnd);
+  if(parsedEnd != token + length)
+  {
+    return false;
+  }
+#endif
+  p = tokenEnd;
+  return true;
+}
+
+/**
+ * @brief SplitLines Splits [begin, end) into about numChunks ranges of similar size that all start at the
+ * beginning of a line, so that the ranges can be parsed independently
+ * @return numChunks + 1 offsets from begin; chunk i is [offsets[i], offsets[i + 1]) and may be empty
+ */
+inline std::vector<size_t> SplitLines(const char* begin, const char* end, size_t numChunks)
+{
+  numChunks = std::max<size_t>(numChunks, 1);
+  size_t size = static_cast<size_t>(end - begin);
+  std::vector<size_t> offsets(numChunks + 1, size);
+  offsets[0] = 0;
+  for(size_t i = 1; i < numChunks; i++)
+  {
+    size_t guess = std::max(size / numChunks * i, offsets[i - 1]);
+    if(guess == 0 || guess >= size)
+    {
+      offsets[i] = std::min(guess, size);
+      continue;
+    }
+    // A chunk starts right after a line feed; if guess is already a line start it stays there
+    offsets[i] = (begin[guess - 1] == '\n') ? guess : static_cast<size_t>(NextLine(begin + guess, end) - begin);
+  }
+  return offsets;
+}
+
+} // namespace TextParsing
+} // namespace SimulationIO
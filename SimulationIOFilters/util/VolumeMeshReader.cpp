@@ -0,0 +1,893 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#include "VolumeMeshReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QObject>
+
+#include "SimulationIO/SimulationIOFilters/util/TextParsing.hpp"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace SimulationIO
+{
+namespace
+{
+/**
+ * @brief Number of records in a chunk; small enough to balance the load, large enough to keep the bookkeeping small
+ */
+const size_t k_RecordsPerChunk = 65536;
+
+const size_t k_InvalidIndex = SIZE_MAX;
+
+/**
+ * @brief IsGmshTetrahedron Returns true for the Gmsh element types of linear and higher order tetrahedra
+ */
+bool IsGmshTetrahedron(int32_t elementType)
+{
+  return elementType == 4 || elementType == 11 || elementType == 29 || elementType == 30 || elementType == 31;
+}
+
+/**
+ * @brief IsNetgenTetrahedron Returns true for the node counts of linear and quadratic Netgen tetrahedra
+ */
+bool IsNetgenTetrahedron(int64_t numPoints)
+{
+  return numPoints == 4 || numPoints == 10;
+}
+
+/**
+ * @brief ReadBinary Copies a value of type T from p, which does not have to be aligned
+ */
+template <typename T>
+T ReadBinary(const char* p)
+{
+  T value;
+  std::memcpy(&value, p, sizeof(T));
+  return value;
+}
+
+/**
+ * @brief Keyword Returns the blank separated token that starts the line at p
+ */
+std::string Keyword(const char* p, const char* end)
+{
+  const char* begin = TextParsing::SkipBlanks(p, end);
+  return std::string(begin, TextParsing::TokenEnd(begin, end));
+}
+} // namespace
+
+/**
+ * @brief The ReadVolumeMeshImpl class reads a range of the node or element chunks of a VolumeMeshReader
+ */
+class ReadVolumeMeshImpl
+{
+public:
+  ReadVolumeMeshImpl(VolumeMeshReader* reader, bool nodes, float* vertices, MeshIndexType* tets, int32_t* regions, char* errors)
+  : m_Reader(reader)
+  , m_Nodes(nodes)
+  , m_Vertices(vertices)
+  , m_Tets(tets)
+  , m_Regions(regions)
+  , m_Errors(errors)
+  {
+  }
+
+  void convert(size_t start, size_t end) const
+  {
+    for(size_t c = start; c < end; c++)
+    {
+      bool ok = m_Nodes ? m_Reader->readNodes(m_Reader->m_NodeChunks[c], m_Vertices) : m_Reader->readElements(m_Reader->m_ElementChunks[c], m_Tets, m_Regions);
+      if(!ok)
+      {
+        m_Errors[c] = 1;
+      }
+    }
+  }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  void operator()(const tbb::blocked_range<size_t>& r) const
+  {
+    convert(r.begin(), r.end());
+  }
+#endif
+
+private:
+  VolumeMeshReader* m_Reader;
+  bool m_Nodes;
+  float* m_Vertices;
+  MeshIndexType* m_Tets;
+  int32_t* m_Regions;
+  char* m_Errors;
+};
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VolumeMeshReader::VolumeMeshReader() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+VolumeMeshReader::~VolumeMeshReader() = default;
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VolumeMeshReader::GetGmshNodesPerElement(int32_t elementType)
+{
+  // Element types 1 to 31 of the Gmsh MSH format
+  static const size_t k_NodesPerElement[] = {0, 2, 3, 4, 4, 8, 6, 5, 3, 6, 9, 10, 27, 18, 14, 1, 8, 20, 15, 13, 9, 10, 12, 15, 15, 21, 4, 5, 6, 20, 35, 56};
+  if(elementType > 0 && elementType < static_cast<int32_t>(sizeof(k_NodesPerElement) / sizeof(k_NodesPerElement[0])))
+  {
+    return k_NodesPerElement[elementType];
+  }
+  if(elementType == 92)
+  {
+    return 64;
+  }
+  if(elementType == 93)
+  {
+    return 125;
+  }
+  return 0;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::open(const QString& path)
+{
+  m_ErrorMessage.clear();
+  m_File.close();
+  m_Buffer.clear();
+  m_Data = nullptr;
+  m_Size = 0;
+  m_NumVertices = 0;
+  m_NumTetrahedra = 0;
+  m_NumSkippedElements = 0;
+  m_MinNodeTag = 1;
+  m_MaxNodeTag = 0;
+  m_NodeIndices.clear();
+  m_NodeChunks.clear();
+  m_ElementChunks.clear();
+
+  m_Path = path;
+  QString suffix = QFileInfo(path).suffix().toLower();
+  if(suffix != "vol" && suffix != "msh")
+  {
+    m_ErrorMessage = QObject::tr("Only Netgen .vol and Gmsh .msh volume meshes can be read: %1").arg(path);
+    return false;
+  }
+
+  m_File.setFileName(path);
+  if(!m_File.open(QIODevice::ReadOnly))
+  {
+    m_ErrorMessage = QObject::tr("Mesh file could not be opened: %1").arg(path);
+    return false;
+  }
+  uchar* mapped = (m_File.size() > 0) ? m_File.map(0, m_File.size()) : nullptr;
+  if(nullptr != mapped)
+  {
+    m_Data = reinterpret_cast<const char*>(mapped);
+    m_Size = static_cast<size_t>(m_File.size());
+  }
+  else
+  {
+    m_Buffer = m_File.readAll();
+    m_Data = m_Buffer.constData();
+    m_Size = static_cast<size_t>(m_Buffer.size());
+  }
+
+  bool indexed = (suffix == "vol") ? indexNetgen() : indexGmsh();
+  if(!indexed)
+  {
+    m_Data = nullptr;
+    return false;
+  }
+
+  // Vertices are stored at (tag - smallest tag) if the tags have no gaps; otherwise in file order with a lookup table
+  if(m_NumVertices > 0 && m_MaxNodeTag - m_MinNodeTag + 1 != static_cast<int64_t>(m_NumVertices))
+  {
+    if(m_MinNodeTag > m_MaxNodeTag || m_MaxNodeTag - m_MinNodeTag + 1 < static_cast<int64_t>(m_NumVertices))
+    {
+      m_ErrorMessage = QObject::tr("Invalid node tag range [%1, %2] for %3 nodes in %4").arg(m_MinNodeTag).arg(m_MaxNodeTag).arg(m_NumVertices).arg(path);
+      m_Data = nullptr;
+      return false;
+    }
+    m_NodeIndices.assign(static_cast<size_t>(m_MaxNodeTag - m_MinNodeTag + 1), k_InvalidIndex);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::indexNetgen()
+{
+  // A .vol file is a list of sections "keyword", record count, one record per line. The points are numbered
+  // implicitly from 1; a volume element is "matnr np p1 ... pnp".
+  m_Format = Format::NetgenVol;
+  const char* p = m_Data;
+  const char* end = m_Data + m_Size;
+  while(true)
+  {
+    p = TextParsing::SkipEmptyLines(p, end);
+    if(p == end)
+    {
+      break;
+    }
+    std::string keyword = Keyword(p, end);
+    p = TextParsing::NextLine(p, end);
+
+    if(keyword == "mesh3d" || keyword == "mesh2d")
+    {
+      continue;
+    }
+    if(keyword == "endmesh")
+    {
+      break;
+    }
+    if(keyword == "dimension" || keyword == "geomtype")
+    {
+      p = TextParsing::NextLine(TextParsing::SkipEmptyLines(p, end), end);
+      continue;
+    }
+
+    p = TextParsing::SkipEmptyLines(p, end);
+    int64_t count = 0;
+    if(!TextParsing::ParseInt(p, end, count) || count < 0)
+    {
+      m_ErrorMessage = QObject::tr("Missing record count after '%1' in %2").arg(QString::fromStdString(keyword)).arg(m_Path);
+      return false;
+    }
+    p = TextParsing::NextLine(p, end);
+
+    bool points = (keyword == "points");
+    bool elements = (keyword == "volumeelements");
+    std::vector<Chunk>& chunks = points ? m_NodeChunks : m_ElementChunks;
+    Chunk chunk;
+    for(int64_t i = 0; i < count; i++)
+    {
+      p = TextParsing::SkipEmptyLines(p, end);
+      if(p == end)
+      {
+        m_ErrorMessage = QObject::tr("Section '%1' of %2 ends after %3 of %4 records").arg(QString::fromStdString(keyword)).arg(m_Path).arg(i).arg(count);
+        return false;
+      }
+      if(!points && !elements)
+      {
+        p = TextParsing::NextLine(p, end);
+        continue;
+      }
+      if(chunk.count == 0)
+      {
+        chunk.begin = p;
+        chunk.first = points ? m_NumVertices : m_NumTetrahedra;
+      }
+      if(points)
+      {
+        m_NumVertices++;
+      }
+      else
+      {
+        const char* q = p;
+        int64_t material = 0;
+        int64_t numPoints = 0;
+        if(!TextParsing::ParseInt(q, end, material) || !TextParsing::ParseInt(q, end, numPoints))
+        {
+          m_ErrorMessage = QObject::tr("Malformed volume element %1 in %2").arg(i + 1).arg(m_Path);
+          return false;
+        }
+        if(IsNetgenTetrahedron(numPoints))
+        {
+          m_NumTetrahedra++;
+        }
+        else
+        {
+          m_NumSkippedElements++;
+        }
+      }
+      chunk.count++;
+      if(chunk.count == k_RecordsPerChunk)
+      {
+        chunks.push_back(chunk);
+        chunk = Chunk();
+      }
+      p = TextParsing::NextLine(p, end);
+    }
+    if(chunk.count > 0)
+    {
+      chunks.push_back(chunk);
+    }
+  }
+
+  m_MinNodeTag = 1;
+  m_MaxNodeTag = static_cast<int64_t>(m_NumVertices);
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::indexGmsh()
+{
+  const char* p = m_Data;
+  const char* end = m_Data + m_Size;
+
+  p = TextParsing::SkipEmptyLines(p, end, 0);
+  if(Keyword(p, end) != "$MeshFormat")
+  {
+    m_ErrorMessage = QObject::tr("Not a Gmsh mesh file: %1").arg(m_Path);
+    return false;
+  }
+  p = TextParsing::NextLine(p, end);
+
+  // version file-type data-size; binary files follow the line with the integer 1 to tell the byte order
+  double version = 0.0;
+  int64_t fileType = 0;
+  int64_t dataSize = 0;
+  if(!TextParsing::ParseDouble(p, end, version) || !TextParsing::ParseInt(p, end, fileType) || !TextParsing::ParseInt(p, end, dataSize))
+  {
+    m_ErrorMessage = QObject::tr("Invalid $MeshFormat section in %1").arg(m_Path);
+    return false;
+  }
+  if(version < 4.05 || version >= 5.0)
+  {
+    m_ErrorMessage = QObject::tr("Only version 4.1 of the Gmsh mesh format can be read, %1 has version %2").arg(m_Path).arg(version);
+    return false;
+  }
+  bool binary = (fileType == 1);
+  p = TextParsing::NextLine(p, end);
+  if(binary)
+  {
+    if(dataSize != static_cast<int64_t>(sizeof(uint64_t)) || static_cast<size_t>(end - p) < sizeof(int32_t) || ReadBinary<int32_t>(p) != 1)
+    {
+      m_ErrorMessage = QObject::tr("The binary Gmsh mesh file was written with a different data size or byte order: %1").arg(m_Path);
+      return false;
+    }
+    p = TextParsing::NextLine(p + sizeof(int32_t), end);
+  }
+  m_Format = binary ? Format::GmshBinary : Format::GmshAscii;
+
+  bool hasNodes = false;
+  while(true)
+  {
+    p = TextParsing::SkipEmptyLines(p, end, 0);
+    if(p == end)
+    {
+      break;
+    }
+    std::string keyword = Keyword(p, end);
+    if(keyword.size() < 2 || keyword[0] != '$')
+    {
+      m_ErrorMessage = QObject::tr("Expected a section at offset %1 of %2").arg(static_cast<qulonglong>(p - m_Data)).arg(m_Path);
+      return false;
+    }
+    p = TextParsing::NextLine(p, end);
+    std::string name = keyword.substr(1);
+    if(name == "EndMeshFormat")
+    {
+      continue;
+    }
+
+    if(name == "Nodes" || name == "Elements")
+    {
+      bool indexed = (name == "Nodes") ? indexGmshNodes(p, end, binary) : indexGmshElements(p, end, binary);
+      if(!indexed)
+      {
+        return false;
+      }
+      hasNodes = hasNodes || (name == "Nodes");
+      p = TextParsing::SkipEmptyLines(p, end, 0);
+      if(Keyword(p, end) != "$End" + name)
+      {
+        m_ErrorMessage = QObject::tr("Section $%1 of %2 does not end where expected").arg(QString::fromStdString(name)).arg(m_Path);
+        return false;
+      }
+      p = TextParsing::NextLine(p, end);
+      continue;
+    }
+
+    // Every other section is skipped as a whole
+    std::string endKeyword = "$End" + name;
+    const char* found = std::search(p, end, endKeyword.begin(), endKeyword.end());
+    if(found == end)
+    {
+      m_ErrorMessage = QObject::tr("Section $%1 of %2 has no end").arg(QString::fromStdString(name)).arg(m_Path);
+      return false;
+    }
+    p = TextParsing::NextLine(found, end);
+  }
+
+  if(!hasNodes)
+  {
+    m_ErrorMessage = QObject::tr("No $Nodes section in %1").arg(m_Path);
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::indexGmshNodes(const char*& p, const char* end, bool binary)
+{
+  // numEntityBlocks numNodes minNodeTag maxNodeTag, then per block "entityDim entityTag parametric numNodesInBlock",
+  // the tags of the block's nodes and their coordinates (x y z, followed by u [v [w]] if parametric)
+  int64_t header[4] = {0, 0, 0, 0};
+  QString truncated = QObject::tr("The $Nodes section of %1 is truncated or malformed").arg(m_Path);
+  if(binary)
+  {
+    if(static_cast<size_t>(end - p) < 4 * sizeof(uint64_t))
+    {
+      m_ErrorMessage = truncated;
+      return false;
+    }
+    for(size_t i = 0; i < 4; i++, p += sizeof(uint64_t))
+    {
+      header[i] = static_cast<int64_t>(ReadBinary<uint64_t>(p));
+    }
+  }
+  else
+  {
+    for(size_t i = 0; i < 4; i++)
+    {
+      if(!TextParsing::ParseInt(p, end, header[i]))
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+    }
+    p = TextParsing::NextLine(p, end);
+  }
+
+  size_t numNodes = 0;
+  for(int64_t b = 0; b < header[0]; b++)
+  {
+    int64_t entityDim = 0;
+    int64_t parametric = 0;
+    int64_t count = 0;
+    if(binary)
+    {
+      if(static_cast<size_t>(end - p) < 3 * sizeof(int32_t) + sizeof(uint64_t))
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      entityDim = ReadBinary<int32_t>(p);
+      parametric = ReadBinary<int32_t>(p + 2 * sizeof(int32_t));
+      count = static_cast<int64_t>(ReadBinary<uint64_t>(p + 3 * sizeof(int32_t)));
+      p += 3 * sizeof(int32_t) + sizeof(uint64_t);
+
+      size_t n = static_cast<size_t>(count);
+      size_t stride = 3 + ((parametric != 0) ? static_cast<size_t>(entityDim) : 0);
+      size_t available = static_cast<size_t>(end - p);
+      if(count < 0 || n > available / sizeof(uint64_t) || n * stride > (available - n * sizeof(uint64_t)) / sizeof(double))
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      const char* coordinates = p + n * sizeof(uint64_t);
+      for(size_t i = 0; i < n; i += k_RecordsPerChunk)
+      {
+        Chunk chunk;
+        chunk.tags = p + i * sizeof(uint64_t);
+        chunk.begin = coordinates + i * stride * sizeof(double);
+        chunk.count = std::min(k_RecordsPerChunk, n - i);
+        chunk.first = numNodes + i;
+        chunk.stride = stride;
+        m_NodeChunks.push_back(chunk);
+      }
+      p = coordinates + n * stride * sizeof(double);
+      numNodes += n;
+      continue;
+    }
+
+    int64_t entityTag = 0;
+    p = TextParsing::SkipEmptyLines(p, end, 0);
+    if(!TextParsing::ParseInt(p, end, entityDim) || !TextParsing::ParseInt(p, end, entityTag) || !TextParsing::ParseInt(p, end, parametric) || !TextParsing::ParseInt(p, end, count) ||
+       count < 0)
+    {
+      m_ErrorMessage = truncated;
+      return false;
+    }
+    p = TextParsing::NextLine(p, end);
+
+    // One tag per line, then one line of coordinates per node
+    size_t n = static_cast<size_t>(count);
+    std::vector<const char*> tags;
+    for(size_t i = 0; i < n; i++)
+    {
+      p = TextParsing::SkipEmptyLines(p, end, 0);
+      if(p == end)
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      if(i % k_RecordsPerChunk == 0)
+      {
+        tags.push_back(p);
+      }
+      p = TextParsing::NextLine(p, end);
+    }
+    for(size_t i = 0; i < n; i++)
+    {
+      p = TextParsing::SkipEmptyLines(p, end, 0);
+      if(p == end)
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      if(i % k_RecordsPerChunk == 0)
+      {
+        Chunk chunk;
+        chunk.tags = tags[i / k_RecordsPerChunk];
+        chunk.begin = p;
+        chunk.count = std::min(k_RecordsPerChunk, n - i);
+        chunk.first = numNodes + i;
+        m_NodeChunks.push_back(chunk);
+      }
+      p = TextParsing::NextLine(p, end);
+    }
+    numNodes += n;
+  }
+
+  if(header[1] < 0 || numNodes != static_cast<size_t>(header[1]))
+  {
+    m_ErrorMessage = QObject::tr("The $Nodes section of %1 should have %2 nodes but has %3").arg(m_Path).arg(header[1]).arg(numNodes);
+    return false;
+  }
+  m_NumVertices = numNodes;
+  m_MinNodeTag = header[2];
+  m_MaxNodeTag = header[3];
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::indexGmshElements(const char*& p, const char* end, bool binary)
+{
+  // numEntityBlocks numElements minElementTag maxElementTag, then per block "entityDim entityTag elementType
+  // numElementsInBlock" and the elements "elementTag nodeTag ..."
+  int64_t numBlocks = 0;
+  QString truncated = QObject::tr("The $Elements section of %1 is truncated or malformed").arg(m_Path);
+  if(binary)
+  {
+    if(static_cast<size_t>(end - p) < 4 * sizeof(uint64_t))
+    {
+      m_ErrorMessage = truncated;
+      return false;
+    }
+    numBlocks = static_cast<int64_t>(ReadBinary<uint64_t>(p));
+    p += 4 * sizeof(uint64_t);
+  }
+  else
+  {
+    if(!TextParsing::ParseInt(p, end, numBlocks))
+    {
+      m_ErrorMessage = truncated;
+      return false;
+    }
+    p = TextParsing::NextLine(p, end);
+  }
+
+  for(int64_t b = 0; b < numBlocks; b++)
+  {
+    int64_t entityDim = 0;
+    int64_t entityTag = 0;
+    int64_t elementType = 0;
+    int64_t count = 0;
+    if(binary)
+    {
+      if(static_cast<size_t>(end - p) < 3 * sizeof(int32_t) + sizeof(uint64_t))
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      entityDim = ReadBinary<int32_t>(p);
+      entityTag = ReadBinary<int32_t>(p + sizeof(int32_t));
+      elementType = ReadBinary<int32_t>(p + 2 * sizeof(int32_t));
+      count = static_cast<int64_t>(ReadBinary<uint64_t>(p + 3 * sizeof(int32_t)));
+      p += 3 * sizeof(int32_t) + sizeof(uint64_t);
+    }
+    else
+    {
+      p = TextParsing::SkipEmptyLines(p, end, 0);
+      if(!TextParsing::ParseInt(p, end, entityDim) || !TextParsing::ParseInt(p, end, entityTag) || !TextParsing::ParseInt(p, end, elementType) || !TextParsing::ParseInt(p, end, count))
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      p = TextParsing::NextLine(p, end);
+    }
+
+    size_t nodesPerElement = GetGmshNodesPerElement(static_cast<int32_t>(elementType));
+    if(count < 0 || (binary && nodesPerElement == 0))
+    {
+      m_ErrorMessage = QObject::tr("Unknown element type %1 in %2").arg(elementType).arg(m_Path);
+      return false;
+    }
+    size_t n = static_cast<size_t>(count);
+    bool tetrahedra = (entityDim == 3 && IsGmshTetrahedron(static_cast<int32_t>(elementType)));
+    if(entityDim == 3 && !tetrahedra)
+    {
+      m_NumSkippedElements += n;
+    }
+
+    if(binary)
+    {
+      size_t recordSize = (1 + nodesPerElement) * sizeof(uint64_t);
+      if(n > static_cast<size_t>(end - p) / recordSize)
+      {
+        m_ErrorMessage = truncated;
+        return false;
+      }
+      for(size_t i = 0; tetrahedra && i < n; i += k_RecordsPerChunk)
+      {
+        Chunk chunk;
+        chunk.begin = p + i * recordSize;
+        chunk.count = std::min(k_RecordsPerChunk, n - i);
+        chunk.first = m_NumTetrahedra + i;
+        chunk.stride = nodesPerElement;
+        chunk.region = static_cast<int32_t>(entityTag);
+        m_ElementChunks.push_back(chunk);
+      }
+      p += n * recordSize;
+    }
+    else
+    {
+      for(size_t i = 0; i < n; i++)
+      {
+        p = TextParsing::SkipEmptyLines(p, end, 0);
+        if(p == end)
+        {
+          m_ErrorMessage = truncated;
+          return false;
+        }
+        if(tetrahedra && i % k_RecordsPerChunk == 0)
+        {
+          Chunk chunk;
+          chunk.begin = p;
+          chunk.count = std::min(k_RecordsPerChunk, n - i);
+          chunk.first = m_NumTetrahedra + i;
+          chunk.stride = nodesPerElement;
+          chunk.region = static_cast<int32_t>(entityTag);
+          m_ElementChunks.push_back(chunk);
+        }
+        p = TextParsing::NextLine(p, end);
+      }
+    }
+    if(tetrahedra)
+    {
+      m_NumTetrahedra += n;
+    }
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::read(float* vertices, MeshIndexType* tets, int32_t* regions)
+{
+  m_ErrorMessage.clear();
+  if(nullptr == m_Data)
+  {
+    m_ErrorMessage = QObject::tr("No mesh file is open");
+    return false;
+  }
+
+  // All nodes have to be in place before the elements can look up their vertex indices
+  std::vector<char> errors(m_NodeChunks.size(), 0);
+  ReadVolumeMeshImpl nodesImpl(this, true, vertices, tets, regions, errors.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, m_NodeChunks.size(), 1), nodesImpl, tbb::simple_partitioner());
+#else
+  nodesImpl.convert(0, m_NodeChunks.size());
+#endif
+  if(std::find(errors.begin(), errors.end(), 1) != errors.end())
+  {
+    m_ErrorMessage = QObject::tr("The nodes of %1 are malformed or have invalid tags").arg(m_Path);
+    return false;
+  }
+
+  errors.assign(m_ElementChunks.size(), 0);
+  ReadVolumeMeshImpl elementsImpl(this, false, vertices, tets, regions, errors.data());
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, m_ElementChunks.size(), 1), elementsImpl, tbb::simple_partitioner());
+#else
+  elementsImpl.convert(0, m_ElementChunks.size());
+#endif
+  if(std::find(errors.begin(), errors.end(), 1) != errors.end())
+  {
+    m_ErrorMessage = QObject::tr("The elements of %1 are malformed or refer to missing nodes").arg(m_Path);
+    return false;
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::readNodes(const Chunk& chunk, float* vertices)
+{
+  const char* end = m_Data + m_Size;
+  const char* p = chunk.begin;
+  const char* t = chunk.tags;
+  for(size_t k = 0; k < chunk.count; k++)
+  {
+    int64_t tag = m_MinNodeTag + static_cast<int64_t>(chunk.first + k);
+    double xyz[3] = {0.0, 0.0, 0.0};
+    if(m_Format == Format::GmshBinary)
+    {
+      tag = static_cast<int64_t>(ReadBinary<uint64_t>(t + k * sizeof(uint64_t)));
+      std::memcpy(xyz, p + k * chunk.stride * sizeof(double), sizeof(xyz));
+    }
+    else
+    {
+      if(m_Format == Format::GmshAscii)
+      {
+        t = TextParsing::SkipEmptyLines(t, end, 0);
+        if(!TextParsing::ParseInt(t, end, tag))
+        {
+          return false;
+        }
+        t = TextParsing::NextLine(t, end);
+      }
+      p = TextParsing::SkipEmptyLines(p, end, (m_Format == Format::NetgenVol) ? '#' : 0);
+      if(!TextParsing::ParseDouble(p, end, xyz[0]) || !TextParsing::ParseDouble(p, end, xyz[1]) || !TextParsing::ParseDouble(p, end, xyz[2]))
+      {
+        return false;
+      }
+      p = TextParsing::NextLine(p, end);
+    }
+
+    if(tag < m_MinNodeTag || tag > m_MaxNodeTag)
+    {
+      return false;
+    }
+    size_t index = chunk.first + k;
+    if(m_NodeIndices.empty())
+    {
+      index = static_cast<size_t>(tag - m_MinNodeTag);
+    }
+    else
+    {
+      m_NodeIndices[static_cast<size_t>(tag - m_MinNodeTag)] = index;
+    }
+    float* vertex = vertices + 3 * index;
+    vertex[0] = static_cast<float>(xyz[0]);
+    vertex[1] = static_cast<float>(xyz[1]);
+    vertex[2] = static_cast<float>(xyz[2]);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::readElements(const Chunk& chunk, MeshIndexType* tets, int32_t* regions) const
+{
+  const char* end = m_Data + m_Size;
+  const char* p = chunk.begin;
+  size_t index = chunk.first;
+  for(size_t k = 0; k < chunk.count; k++)
+  {
+    MeshIndexType* tet = tets + 4 * index;
+    if(m_Format == Format::GmshBinary)
+    {
+      // elementTag nodeTag ... ; the corner nodes come first
+      const char* record = p + k * (1 + chunk.stride) * sizeof(uint64_t);
+      for(size_t j = 0; j < 4; j++)
+      {
+        if(!getVertexIndex(static_cast<int64_t>(ReadBinary<uint64_t>(record + (1 + j) * sizeof(uint64_t))), tet[j]))
+        {
+          return false;
+        }
+      }
+      regions[index++] = chunk.region;
+      continue;
+    }
+
+    int64_t region = chunk.region;
+    int64_t numPoints = static_cast<int64_t>(chunk.stride);
+    if(m_Format == Format::NetgenVol)
+    {
+      p = TextParsing::SkipEmptyLines(p, end);
+      if(!TextParsing::ParseInt(p, end, region) || !TextParsing::ParseInt(p, end, numPoints))
+      {
+        return false;
+      }
+      if(!IsNetgenTetrahedron(numPoints))
+      {
+        p = TextParsing::NextLine(p, end);
+        continue;
+      }
+    }
+    else
+    {
+      int64_t elementTag = 0;
+      p = TextParsing::SkipEmptyLines(p, end, 0);
+      if(!TextParsing::ParseInt(p, end, elementTag))
+      {
+        return false;
+      }
+    }
+    for(size_t j = 0; j < 4; j++)
+    {
+      int64_t node = 0;
+      if(!TextParsing::ParseInt(p, end, node) || !getVertexIndex(node, tet[j]))
+      {
+        return false;
+      }
+    }
+    regions[index++] = static_cast<int32_t>(region);
+    p = TextParsing::NextLine(p, end);
+  }
+  return true;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+bool VolumeMeshReader::getVertexIndex(int64_t tag, MeshIndexType& index) const
+{
+  if(tag < m_MinNodeTag || tag > m_MaxNodeTag)
+  {
+    return false;
+  }
+  size_t offset = static_cast<size_t>(tag - m_MinNodeTag);
+  if(m_NodeIndices.empty())
+  {
+    index = static_cast<MeshIndexType>(offset);
+    return offset < m_NumVertices;
+  }
+  index = static_cast<MeshIndexType>(m_NodeIndices[offset]);
+  return m_NodeIndices[offset] != k_InvalidIndex;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VolumeMeshReader::getNumberOfVertices() const
+{
+  return m_NumVertices;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VolumeMeshReader::getNumberOfTetrahedra() const
+{
+  return m_NumTetrahedra;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+size_t VolumeMeshReader::getNumberOfSkippedElements() const
+{
+  return m_NumSkippedElements;
+}
+
+// -----------------------------------------------------------------------------
+//
+// -----------------------------------------------------------------------------
+QString VolumeMeshReader::getErrorMessage() const
+{
+  return m_ErrorMessage;
+}
+
+} // namespace SimulationIO
@@ -0,0 +1,128 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "SimulationIO/SimulationIODLLExport.h"
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The VolumeMeshReader class reads the tetrahedra of a volume mesh written by an external meshing package:
+ * Netgen .vol files and Gmsh .msh files of version 4.1, ASCII or binary. The file is memory mapped and indexed by
+ * open(), which gives the number of vertices and tetrahedra, so the caller can size its arrays. read() then parses
+ * the file in parallel chunks (when SIMPLib is built with TBB) straight into those arrays.
+ *
+ * Every tetrahedron gets a region number: the material number of a Netgen volume element, or the tag of the Gmsh
+ * volume entity that contains it. Only the four corner nodes of higher order tetrahedra are kept. Volume elements
+ * that are not tetrahedra are skipped and counted; lower dimensional elements are ignored.
+ */
+class SimulationIO_EXPORT VolumeMeshReader
+{
+public:
+  VolumeMeshReader();
+  ~VolumeMeshReader();
+
+  /**
+   * @brief open Maps and indexes a mesh file. The format is chosen by the extension (.vol or .msh).
+   * @param path
+   * @return false on error, see getErrorMessage()
+   */
+  bool open(const QString& path);
+
+  /**
+   * @brief read Reads the mesh of the last successful open()
+   * @param vertices Receives 3 coordinates for each of the getNumberOfVertices() vertices
+   * @param tets Receives 4 vertex indices for each of the getNumberOfTetrahedra() tetrahedra
+   * @param regions Receives the region number of each tetrahedron
+   * @return false on error, see getErrorMessage()
+   */
+  bool read(float* vertices, MeshIndexType* tets, int32_t* regions);
+
+  size_t getNumberOfVertices() const;
+  size_t getNumberOfTetrahedra() const;
+
+  /**
+   * @brief getNumberOfSkippedElements Returns the number of volume elements that are not tetrahedra
+   */
+  size_t getNumberOfSkippedElements() const;
+
+  /**
+   * @brief getErrorMessage Returns why the last open() or read() failed
+   */
+  QString getErrorMessage() const;
+
+  /**
+   * @brief GetGmshNodesPerElement Returns the number of nodes of a Gmsh element type, or 0 for unknown types
+   */
+  static size_t GetGmshNodesPerElement(int32_t elementType);
+
+private:
+  enum class Format : int
+  {
+    NetgenVol,
+    GmshAscii,
+    GmshBinary
+  };
+
+  /**
+   * @brief The Chunk struct is a run of consecutive records that can be parsed independently of the others
+   */
+  struct Chunk
+  {
+    const char* begin = nullptr; // First record (coordinates of a node, or an element)
+    const char* tags = nullptr;  // Gmsh nodes: first node tag
+    size_t count = 0;            // Number of records
+    size_t first = 0;            // Output index of the first node or tetrahedron
+    size_t stride = 0;           // Values per record (binary Gmsh) or nodes per element
+    int32_t region = 0;          // Gmsh elements: tag of the volume entity
+  };
+
+  QString m_Path;
+  QFile m_File;
+  QByteArray m_Buffer;
+  const char* m_Data = nullptr;
+  size_t m_Size = 0;
+  Format m_Format = Format::NetgenVol;
+
+  size_t m_NumVertices = 0;
+  size_t m_NumTetrahedra = 0;
+  size_t m_NumSkippedElements = 0;
+  int64_t m_MinNodeTag = 1;
+  int64_t m_MaxNodeTag = 0;
+  std::vector<size_t> m_NodeIndices;
+  std::vector<Chunk> m_NodeChunks;
+  std::vector<Chunk> m_ElementChunks;
+  QString m_ErrorMessage;
+
+  bool indexNetgen();
+  bool indexGmsh();
+  bool indexGmshNodes(const char*& p, const char* end, bool binary);
+  bool indexGmshElements(const char*& p, const char* end, bool binary);
+
+  bool readNodes(const Chunk& chunk, float* vertices);
+  bool readElements(const Chunk& chunk, MeshIndexType* tets, int32_t* regions) const;
+  bool getVertexIndex(int64_t tag, MeshIndexType& index) const;
+
+  friend class ReadVolumeMeshImpl;
+
+public:
+  VolumeMeshReader(const VolumeMeshReader&) = delete;            // Copy Constructor Not Implemented
+  VolumeMeshReader(VolumeMeshReader&&) = delete;                 // Move Constructor Not Implemented
+  VolumeMeshReader& operator=(const VolumeMeshReader&) = delete; // Copy Assignment Not Implemented
+  VolumeMeshReader& operator=(VolumeMeshReader&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
@@ -0,0 +1,279 @@
+/*
+ * Your License or Copyright can go here
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QSysInfo>
+
+#include "SIMPLib/SIMPLib.h"
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#endif
+
+namespace SimulationIO
+{
+
+/**
+ * @brief The VtkAppendedDataWriter class writes data arrays to the raw binary <AppendedData> section of a
+ * VTK XML file that declares header_type="UInt64". Without compression an array is its byte count followed
+ * by the bytes. With compression the array is split into blocks that are compressed with zlib independently
+ * (in parallel when SIMPLib is built with TBB), in the layout read by vtkZLibDataCompressor:
+ * [number of blocks, block size, size of the last partial block, compressed size of each block] followed
+ * by the compressed blocks.
+ *
+ * Large arrays are produced block by block through a fill function, so only a bounded batch of blocks is
+ * held in memory at any time.
+ */
+class VtkAppendedDataWriter
+{
+public:
+  /**
+   * @brief Called as fill(buffer, start, end) to write the values [start, end) of the array into buffer
+   */
+  using FillFunctionType = std::function<void(char* buffer, size_t start, size_t end)>;
+
+  VtkAppendedDataWriter(FILE* file, bool compress)
+  : m_File(file)
+  , m_Compress(compress)
+  {
+  }
+
+  ~VtkAppendedDataWriter() = default;
+
+  /**
+   * @brief setBlockSize Sets the uncompressed size of a block in bytes
+   * @param numBytes
+   */
+  void setBlockSize(size_t numBytes)
+  {
+    m_BlockSize = std::max<size_t>(numBytes, 1024);
+  }
+
+  size_t getBlockSize() const
+  {
+    return m_BlockSize;
+  }
+
+  /**
+   * @brief GetByteOrder Returns the byte_order attribute that matches this machine
+   */
+  static const char* GetByteOrder()
+  {
+    return (QSysInfo::ByteOrder == QSysInfo::LittleEndian) ? "LittleEndian" : "BigEndian";
+  }
+
+  /**
+   * @brief getCompressorAttribute Returns the attribute that has to be added to the VTKFile element
+   */
+  const char* getCompressorAttribute() const
+  {
+    return m_Compress ? " compressor=\"vtkZLibDataCompressor\"" : "";
+  }
+
+  /**
+   * @brief encode Encodes a small array in memory, e.g. to compute the offsets of the arrays that follow it
+   * @param data
+   * @param numBytes
+   * @return The encoded array, header included
+   */
+  QByteArray encode(const char* data, size_t numBytes) const
+  {
+    QByteArray encoded;
+    if(!m_Compress)
+    {
+      uint64_t header = numBytes;
+      encoded.append(reinterpret_cast<const char*>(&header), sizeof(header));
+      encoded.append(data, static_cast<int>(numBytes));
+      return encoded;
+    }
+
+    size_t numBlocks = (numBytes + m_BlockSize - 1) / m_BlockSize;
+    std::vector<uint64_t> header = CreateCompressedHeader(numBytes, numBlocks, m_BlockSize);
+    QByteArray blocks;
+    for(size_t b = 0; b < numBlocks; b++)
+    {
+      size_t begin = b * m_BlockSize;
+      size_t blockBytes = std::min(m_BlockSize, numBytes - begin);
+      QByteArray compressed = qCompress(reinterpret_cast<const uchar*>(data + begin), static_cast<int>(blockBytes), k_CompressionLevel);
+      header[3 + b] = static_cast<uint64_t>(compressed.size() - k_QtSizePrefix);
+      blocks.append(compressed.constData() + k_QtSizePrefix, compressed.size() - k_QtSizePrefix);
+    }
+    encoded.append(reinterpret_cast<const char*>(header.data()), static_cast<int>(header.size() * sizeof(uint64_t)));
+    encoded.append(blocks);
+    return encoded;
+  }
+
+  /**
+   * @brief write Encodes an array of numValues values of valueSize bytes each and appends it to the file
+   * @param numValues
+   * @param valueSize
+   * @param fill
+   * @return false if the file could not be written
+   */
+  bool write(size_t numValues, size_t valueSize, const FillFunctionType& fill) const
+  {
+    if(nullptr == m_File || valueSize == 0)
+    {
+      return false;
+    }
+
+    size_t valuesPerBlock = std::max<size_t>(m_BlockSize / valueSize, 1);
+    size_t blockBytes = valuesPerBlock * valueSize;
+    size_t numBytes = numValues * valueSize;
+    size_t numBlocks = (numValues + valuesPerBlock - 1) / valuesPerBlock;
+
+    if(!m_Compress)
+    {
+      uint64_t header = numBytes;
+      if(fwrite(&header, sizeof(header), 1, m_File) != 1)
+      {
+        return false;
+      }
+      std::vector<char> buffer(std::min(blockBytes, numBytes));
+      for(size_t b = 0; b < numBlocks; b++)
+      {
+        size_t start = b * valuesPerBlock;
+        size_t end = std::min(start + valuesPerBlock, numValues);
+        size_t bytes = (end - start) * valueSize;
+        fill(buffer.data(), start, end);
+        if(fwrite(buffer.data(), 1, bytes, m_File) != bytes)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    // The compressed sizes are only known once the blocks are written, so the header is written
+    // as a placeholder first and filled in at the end
+    std::vector<uint64_t> header = CreateCompressedHeader(numBytes, numBlocks, blockBytes);
+    fpos_t headerPos;
+    if(fgetpos(m_File, &headerPos) != 0 || fwrite(header.data(), sizeof(uint64_t), header.size(), m_File) != header.size())
+    {
+      return false;
+    }
+
+    size_t batchSize = std::min(GetBatchSize(), numBlocks);
+    std::vector<QByteArray> compressed(batchSize);
+    for(size_t firstBlock = 0; firstBlock < numBlocks; firstBlock += batchSize)
+    {
+      size_t blocksInBatch = std::min(batchSize, numBlocks - firstBlock);
+      CompressBlocksImpl impl(fill, compressed.data(), firstBlock, valuesPerBlock, valueSize, numValues);
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+      tbb::parallel_for(tbb::blocked_range<size_t>(0, blocksInBatch, 1), impl, tbb::simple_partitioner());
+#else
+      impl.compress(0, blocksInBatch);
+#endif
+      for(size_t b = 0; b < blocksInBatch; b++)
+      {
+        size_t size = static_cast<size_t>(compressed[b].size() - k_QtSizePrefix);
+        header[3 + firstBlock + b] = size;
+        if(fwrite(compressed[b].constData() + k_QtSizePrefix, 1, size, m_File) != size)
+        {
+          return false;
+        }
+      }
+    }
+
+    if(fsetpos(m_File, &headerPos) != 0 || fwrite(header.data(), sizeof(uint64_t), header.size(), m_File) != header.size())
+    {
+      return false;
+    }
+    return fseek(m_File, 0, SEEK_END) == 0;
+  }
+
+  /**
+   * @brief GetBatchSize Returns how many blocks are compressed before they are flushed to disk
+   */
+  static size_t GetBatchSize()
+  {
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    return 2 * std::max<size_t>(std::thread::hardware_concurrency(), 1);
+#else
+    return 1;
+#endif
+  }
+
+private:
+  FILE* m_File = nullptr;
+  bool m_Compress = false;
+  size_t m_BlockSize = 1024 * 1024;
+
+  // zlib level 1: label and coordinate data compresses well already, and speed is what matters here
+  static const int k_CompressionLevel = 1;
+  // qCompress prefixes the zlib stream with the uncompressed size as a 4 byte big endian integer
+  static const int k_QtSizePrefix = 4;
+
+  static std::vector<uint64_t> CreateCompressedHeader(size_t numBytes, size_t numBlocks, size_t blockBytes)
+  {
+    std::vector<uint64_t> header(3 + numBlocks, 0);
+    header[0] = numBlocks;
+    header[1] = blockBytes;
+    header[2] = numBytes % blockBytes;
+    return header;
+  }
+
+  /**
+   * @brief The CompressBlocksImpl class fills and compresses a range of blocks of the current batch
+   */
+  class CompressBlocksImpl
+  {
+  public:
+    CompressBlocksImpl(const FillFunctionType& fill, QByteArray* compressed, size_t firstBlock, size_t valuesPerBlock, size_t valueSize, size_t numValues)
+    : m_Fill(fill)
+    , m_Compressed(compressed)
+    , m_FirstBlock(firstBlock)
+    , m_ValuesPerBlock(valuesPerBlock)
+    , m_ValueSize(valueSize)
+    , m_NumValues(numValues)
+    {
+    }
+
+    void compress(size_t start, size_t end) const
+    {
+      std::vector<char> buffer(m_ValuesPerBlock * m_ValueSize);
+      for(size_t b = start; b < end; b++)
+      {
+        size_t first = (m_FirstBlock + b) * m_ValuesPerBlock;
+        size_t last = std::min(first + m_ValuesPerBlock, m_NumValues);
+        m_Fill(buffer.data(), first, last);
+        m_Compressed[b] = qCompress(reinterpret_cast<const uchar*>(buffer.data()), static_cast<int>((last - first) * m_ValueSize), k_CompressionLevel);
+      }
+    }
+
+#ifdef SIMPL_USE_PARALLEL_ALGORITHMS
+    void operator()(const tbb::blocked_range<size_t>& r) const
+    {
+      compress(r.begin(), r.end());
+    }
+#endif
+
+  private:
+    const FillFunctionType& m_Fill;
+    QByteArray* m_Compressed;
+    size_t m_FirstBlock;
+    size_t m_ValuesPerBlock;
+    size_t m_ValueSize;
+    size_t m_NumValues;
+  };
+
+public:
+  VtkAppendedDataWriter(const VtkAppendedDataWriter&) = delete;            // Copy Constructor Not Implemented
+  VtkAppendedDataWriter(VtkAppendedDataWriter&&) = delete;                 // Move Constructor Not Implemented
+  VtkAppendedDataWriter& operator=(const VtkAppendedDataWriter&) = delete; // Copy Assignment Not Implemented
+  VtkAppendedDataWriter& operator=(VtkAppendedDataWriter&&) = delete;      // Move Assignment Not Implemented
+};
+
+} // namespace SimulationIO
@@ -0,0 +1,91 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SimulationIO/SimulationIOFilters/util/ExternalJobRunner.h"
+
+class ExternalJobRunnerTest
+{
+
+public:
+  ExternalJobRunnerTest() = default;
+  ~ExternalJobRunnerTest() = default;
+  ExternalJobRunnerTest(const ExternalJobRunnerTest&) = delete;            // Copy Constructor
+  ExternalJobRunnerTest(ExternalJobRunnerTest&&) = delete;                 // Move Constructor
+  ExternalJobRunnerTest& operator=(const ExternalJobRunnerTest&) = delete; // Copy Assignment
+  ExternalJobRunnerTest& operator=(ExternalJobRunnerTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSplitUnquotedArguments()
+  {
+    using SimulationIO::ExternalJobRunner;
+
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("gmsh -3 -format msh4") == QStringList() << "gmsh"
+                                                                                                << "-3"
+                                                                                                << "-format"
+                                                                                                << "msh4")
+
+    // Repeated, leading and trailing white space does not make empty arguments
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("  a   b\t\tc  ") == QStringList() << "a"
+                                                                                          << "b"
+                                                                                          << "c")
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("").isEmpty())
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("   ").isEmpty())
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestSplitQuotedArguments()
+  {
+    using SimulationIO::ExternalJobRunner;
+
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("abaqus python \"my script.py\" -- a") == QStringList() << "abaqus"
+                                                                                                              << "python"
+                                                                                                              << "my script.py"
+                                                                                                              << "--"
+                                                                                                              << "a")
+
+    // White space inside quotes is kept as it is; the quotes themselves are dropped
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("\"x  y\" z") == QStringList() << "x  y"
+                                                                                    << "z")
+
+    // A quoted part joins the text next to it into one argument
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("\"a b\"c d") == QStringList() << "a bc"
+                                                                                    << "d")
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("-o\"out dir\"") == QStringList() << "-oout dir")
+
+    // Empty quotes are an empty argument
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("\"\"") == QStringList() << "")
+    DREAM3D_REQUIRE(ExternalJobRunner::SplitArguments("a \"\" b") == QStringList() << "a"
+                                                                                  << ""
+                                                                                  << "b")
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestSplitUnquotedArguments())
+    DREAM3D_REGISTER_TEST(TestSplitQuotedArguments())
+  }
+
+private:
+};
@@ -0,0 +1,227 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QMap>
+#include <QtCore/QString>
+#include <QtCore/QStringList>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SimulationIO/SimulationIOFilters/util/NetgenVolMerger.h"
+
+#include "SimulationIOTestFileLocations.h"
+
+class NetgenVolMergerTest
+{
+
+public:
+  NetgenVolMergerTest() = default;
+  ~NetgenVolMergerTest() = default;
+  NetgenVolMergerTest(const NetgenVolMergerTest&) = delete;            // Copy Constructor
+  NetgenVolMergerTest(NetgenVolMergerTest&&) = delete;                 // Move Constructor
+  NetgenVolMergerTest& operator=(const NetgenVolMergerTest&) = delete; // Copy Assignment
+  NetgenVolMergerTest& operator=(NetgenVolMergerTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::NetgenVolMergerTest::InputFile1);
+    QFile::remove(UnitTest::NetgenVolMergerTest::InputFile2);
+    QFile::remove(UnitTest::NetgenVolMergerTest::OutputFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  // Writes a .vol file with one tetrahedron at x of the given material, its four boundary triangles (surfaces 1 to 4,
+  // outside domain 0), one edge segment and a section the merger does not understand
+  // -----------------------------------------------------------------------------
+  void WriteOneTetVolFile(const QString& path, int x, const QByteArray& materialName)
+  {
+    QByteArray contents;
+    contents += "mesh3d\n"
+                "dimension\n"
+                "3\n"
+                "geomtype\n"
+                "0\n"
+                "\n"
+                "# surfnr    bcnr   domin  domout      np      p1      p2      p3\n"
+                "surfaceelementsgi\n"
+                "4\n"
+                "1 1 1 0 3 1 3 2 0 0 0\n"
+                "2 1 1 0 3 1 2 4 0 0 0\n"
+                "3 1 1 0 3 2 3 4 0 0 0\n"
+                "4 1 1 0 3 3 1 4 0 0 0\n"
+                "\n"
+                "#  matnr      np      p1      p2      p3      p4\n"
+                "volumeelements\n"
+                "1\n"
+                "1 4 1 2 3 4\n"
+                "\n"
+                "# surfid  0   p1   p2   trignum1    trignum2   domin/surfnr1    domout/surfnr2   ednr1   dist1   ednr2   dist2\n"
+                "edgesegmentsgi2\n"
+                "1\n"
+                "1 0 1 2 0 0 1 2 1 0.5 1 0.25\n"
+                "\n"
+                "pointelements\n"
+                "1\n"
+                "1 1\n"
+                "\n"
+                "#          X             Y             Z\n"
+                "points\n"
+                "4\n";
+    contents += QByteArray::number(x) + " 0 0\n";
+    contents += QByteArray::number(x + 1) + " 0 0\n";
+    contents += QByteArray::number(x) + " 1 0\n";
+    contents += QByteArray::number(x) + " 0 1\n";
+    contents += "\n"
+                "materials\n"
+                "1\n"
+                "1 " +
+                materialName +
+                "\n"
+                "\n"
+                "endmesh\n";
+
+    QFile file(path);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size())
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  // Returns the records of every counted section of a .vol file, with the white space simplified
+  // -----------------------------------------------------------------------------
+  QMap<QString, QStringList> ReadVolSections(const QString& path)
+  {
+    QFile file(path);
+    DREAM3D_REQUIRE(file.open(QIODevice::ReadOnly))
+    QStringList lines;
+    for(const QByteArray& line : file.readAll().split('\n'))
+    {
+      QString simplified = QString::fromLatin1(line).simplified();
+      if(!simplified.isEmpty() && !simplified.startsWith('#'))
+      {
+        lines << simplified;
+      }
+    }
+
+    QMap<QString, QStringList> sections;
+    for(int i = 0; i < lines.size(); i++)
+    {
+      if(lines[i] == "mesh3d" || lines[i] == "endmesh")
+      {
+        continue;
+      }
+      if(lines[i] == "dimension" || lines[i] == "geomtype")
+      {
+        sections[lines[i]] << lines[i + 1];
+        i++;
+        continue;
+      }
+      QString name = lines[i];
+      int count = lines[i + 1].toInt();
+      sections[name] = lines.mid(i + 2, count);
+      i += 1 + count;
+    }
+    return sections;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMergeOneTetFiles()
+  {
+    WriteOneTetVolFile(UnitTest::NetgenVolMergerTest::InputFile1, 0, "grain1");
+    WriteOneTetVolFile(UnitTest::NetgenVolMergerTest::InputFile2, 2, "grain2");
+
+    SimulationIO::NetgenVolMerger merger;
+    bool merged = merger.merge(QStringList() << UnitTest::NetgenVolMergerTest::InputFile1 << UnitTest::NetgenVolMergerTest::InputFile2, UnitTest::NetgenVolMergerTest::OutputFile);
+    DREAM3D_REQUIRE(merged)
+    DREAM3D_REQUIRE(merger.getErrorMessage().isEmpty())
+    DREAM3D_REQUIRE(merger.getDroppedSections() == QStringList() << "pointelements")
+
+    QMap<QString, QStringList> sections = ReadVolSections(UnitTest::NetgenVolMergerTest::OutputFile);
+    DREAM3D_REQUIRE(sections["dimension"] == QStringList() << "3")
+    DREAM3D_REQUIRE(sections["geomtype"] == QStringList() << "0")
+    DREAM3D_REQUIRE(!sections.contains("pointelements"))
+
+    // Points of the second file follow those of the first, unchanged
+    const QStringList& points = sections["points"];
+    DREAM3D_REQUIRE_EQUAL(points.size(), 8)
+    DREAM3D_REQUIRE(points[0] == "0 0 0")
+    DREAM3D_REQUIRE(points[3] == "0 0 1")
+    DREAM3D_REQUIRE(points[4] == "2 0 0")
+    DREAM3D_REQUIRE(points[7] == "2 0 1")
+
+    // Surface numbers shift by 4, the inside domain by 1 and the points by 4; domout 0 (outside) stays 0 and the
+    // geometry info after the points is copied
+    const QStringList& surfaceElements = sections["surfaceelementsgi"];
+    DREAM3D_REQUIRE_EQUAL(surfaceElements.size(), 8)
+    DREAM3D_REQUIRE(surfaceElements[0] == "1 1 1 0 3 1 3 2 0 0 0")
+    DREAM3D_REQUIRE(surfaceElements[3] == "4 1 1 0 3 3 1 4 0 0 0")
+    DREAM3D_REQUIRE(surfaceElements[4] == "5 1 2 0 3 5 7 6 0 0 0")
+    DREAM3D_REQUIRE(surfaceElements[7] == "8 1 2 0 3 7 5 8 0 0 0")
+
+    // The material of the second tetrahedron becomes 2, as with "netgen -mergefile"
+    const QStringList& volumeElements = sections["volumeelements"];
+    DREAM3D_REQUIRE(volumeElements == QStringList() << "1 4 1 2 3 4"
+                                                    << "2 4 5 6 7 8")
+
+    // surfid, points, surfnr1/2 and both edge numbers shift; trignums and distances do not
+    const QStringList& edgeSegments = sections["edgesegmentsgi2"];
+    DREAM3D_REQUIRE(edgeSegments == QStringList() << "1 0 1 2 0 0 1 2 1 0.5 1 0.25"
+                                                  << "5 0 5 6 0 0 5 6 2 0.5 2 0.25")
+
+    const QStringList& materials = sections["materials"];
+    DREAM3D_REQUIRE(materials == QStringList() << "1 grain1"
+                                               << "2 grain2")
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestMergeErrors()
+  {
+    WriteOneTetVolFile(UnitTest::NetgenVolMergerTest::InputFile1, 0, "grain1");
+
+    SimulationIO::NetgenVolMerger merger;
+    DREAM3D_REQUIRE(!merger.merge(QStringList() << UnitTest::NetgenVolMergerTest::InputFile1, UnitTest::NetgenVolMergerTest::InputFile1))
+    DREAM3D_REQUIRE(!merger.getErrorMessage().isEmpty())
+
+    // A section with fewer records than its count
+    QFile file(UnitTest::NetgenVolMergerTest::InputFile2);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    file.write("mesh3d\nvolumeelements\n2\n1 4 1 2 3 4\n");
+    file.close();
+    DREAM3D_REQUIRE(!merger.merge(QStringList() << UnitTest::NetgenVolMergerTest::InputFile1 << UnitTest::NetgenVolMergerTest::InputFile2, UnitTest::NetgenVolMergerTest::OutputFile))
+    DREAM3D_REQUIRE(!merger.getErrorMessage().isEmpty())
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestMergeOneTetFiles())
+    DREAM3D_REGISTER_TEST(TestMergeErrors())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+};
@@ -0,0 +1,326 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <map>
+#include <numeric>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SimulationIO/SimulationIOFilters/util/SurfaceMeshPreconditioner.h"
+
+class SurfaceMeshPreconditionerTest
+{
+
+public:
+  SurfaceMeshPreconditionerTest() = default;
+  ~SurfaceMeshPreconditionerTest() = default;
+  SurfaceMeshPreconditionerTest(const SurfaceMeshPreconditionerTest&) = delete;            // Copy Constructor
+  SurfaceMeshPreconditionerTest(SurfaceMeshPreconditionerTest&&) = delete;                 // Move Constructor
+  SurfaceMeshPreconditionerTest& operator=(const SurfaceMeshPreconditionerTest&) = delete; // Copy Assignment
+  SurfaceMeshPreconditionerTest& operator=(SurfaceMeshPreconditionerTest&&) = delete;      // Move Assignment
+
+  // Cells per unit edge of the grains and their size
+  const int k_Cells = 4;
+  const float k_CellSize = 0.25f;
+  const int32_t k_Outside = -1;
+
+  /**
+   * @brief The SurfaceMesh struct is a labeled triangle soup: every triangle has its own three vertices
+   */
+  struct SurfaceMesh
+  {
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> triangles;
+    std::vector<int32_t> labels;
+
+    void addTriangle(const float* p0, const float* p1, const float* p2, int32_t label0, int32_t label1)
+    {
+      for(const float* p : {p0, p1, p2})
+      {
+        triangles.push_back(static_cast<MeshIndexType>(vertices.size() / 3));
+        vertices.insert(vertices.end(), p, p + 3);
+      }
+      labels.push_back(label0);
+      labels.push_back(label1);
+    }
+  };
+
+  // -----------------------------------------------------------------------------
+  // Adds a square side of k_Cells x k_Cells cells, spanned by the lattice directions a and b from the lattice point
+  // origin. The triangles face a x b, which points out of grain label0.
+  // -----------------------------------------------------------------------------
+  void AddSide(SurfaceMesh& mesh, const int origin[3], const int a[3], const int b[3], int32_t label0, int32_t label1)
+  {
+    for(int i = 0; i < k_Cells; i++)
+    {
+      for(int j = 0; j < k_Cells; j++)
+      {
+        float corners[4][3];
+        for(int c = 0; c < 3; c++)
+        {
+          corners[0][c] = static_cast<float>(origin[c] + i * a[c] + j * b[c]) * k_CellSize;
+          corners[1][c] = static_cast<float>(origin[c] + (i + 1) * a[c] + j * b[c]) * k_CellSize;
+          corners[2][c] = static_cast<float>(origin[c] + (i + 1) * a[c] + (j + 1) * b[c]) * k_CellSize;
+          corners[3][c] = static_cast<float>(origin[c] + i * a[c] + (j + 1) * b[c]) * k_CellSize;
+        }
+        mesh.addTriangle(corners[0], corners[1], corners[2], label0, label1);
+        mesh.addTriangle(corners[0], corners[2], corners[3], label0, label1);
+      }
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Two unit cube grains side by side along x: grain 1 in [0, 1], grain 2 in [1, 2]. The boundary patches are the
+  // outside of grain 1, the outside of grain 2 and the wall between them at x = 1, so the only curve is the square
+  // where the wall meets the outside.
+  // -----------------------------------------------------------------------------
+  SurfaceMesh CreateTwoGrainBox()
+  {
+    const int n = k_Cells;
+    const int x[3] = {1, 0, 0};
+    const int y[3] = {0, 1, 0};
+    const int z[3] = {0, 0, 1};
+
+    SurfaceMesh mesh;
+    for(int32_t grain = 1; grain <= 2; grain++)
+    {
+      int x0 = (grain - 1) * n;
+      const int low[3] = {x0, 0, 0};
+      const int highY[3] = {x0, n, 0};
+      const int highZ[3] = {x0, 0, n};
+      AddSide(mesh, low, y, x, grain, k_Outside);   // z = 0
+      AddSide(mesh, highZ, x, y, grain, k_Outside); // z = 1
+      AddSide(mesh, low, x, z, grain, k_Outside);   // y = 0
+      AddSide(mesh, highY, z, x, grain, k_Outside); // y = 1
+    }
+    const int left[3] = {0, 0, 0};
+    const int wall[3] = {n, 0, 0};
+    const int right[3] = {2 * n, 0, 0};
+    AddSide(mesh, left, z, y, 1, k_Outside);
+    AddSide(mesh, wall, y, z, 1, 2);
+    AddSide(mesh, right, y, z, 2, k_Outside);
+    return mesh;
+  }
+
+  // -----------------------------------------------------------------------------
+  // Checks that the surface of every grain is closed, consistently oriented and a topological sphere
+  // -----------------------------------------------------------------------------
+  void CheckGrainsClosed(const std::vector<MeshIndexType>& triangles, const std::vector<int32_t>& labels)
+  {
+    size_t numTriangles = triangles.size() / 3;
+    for(int32_t grain = 1; grain <= 2; grain++)
+    {
+      std::map<std::pair<MeshIndexType, MeshIndexType>, size_t> edges;
+      std::set<MeshIndexType> vertices;
+      size_t numFaces = 0;
+      for(size_t t = 0; t < numTriangles; t++)
+      {
+        if(labels[2 * t] != grain && labels[2 * t + 1] != grain)
+        {
+          continue;
+        }
+        // Oriented out of the grain
+        MeshIndexType tri[3] = {triangles[3 * t], triangles[3 * t + 1], triangles[3 * t + 2]};
+        if(labels[2 * t] != grain)
+        {
+          std::swap(tri[1], tri[2]);
+        }
+        for(size_t c = 0; c < 3; c++)
+        {
+          edges[std::make_pair(tri[c], tri[(c + 1) % 3])]++;
+          vertices.insert(tri[c]);
+        }
+        numFaces++;
+      }
+
+      // Every edge is used once in each direction
+      for(const auto& edge : edges)
+      {
+        DREAM3D_REQUIRE_EQUAL(edge.second, 1)
+        auto reverse = edges.find(std::make_pair(edge.first.second, edge.first.first));
+        DREAM3D_REQUIRE(reverse != edges.end())
+      }
+      int64_t euler = static_cast<int64_t>(vertices.size()) - static_cast<int64_t>(edges.size() / 2) + static_cast<int64_t>(numFaces);
+      DREAM3D_REQUIRE_EQUAL(euler, 2)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  // Checks that the faces form the three boundary patches of the box, each of them connected
+  // -----------------------------------------------------------------------------
+  void CheckPatches(const std::vector<MeshIndexType>& triangles, const std::vector<int32_t>& labels)
+  {
+    size_t numTriangles = triangles.size() / 3;
+    std::vector<std::pair<int32_t, int32_t>> patches(numTriangles);
+    std::set<std::pair<int32_t, int32_t>> patchSet;
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      patches[t] = std::make_pair(std::min(labels[2 * t], labels[2 * t + 1]), std::max(labels[2 * t], labels[2 * t + 1]));
+      patchSet.insert(patches[t]);
+    }
+    std::set<std::pair<int32_t, int32_t>> expected = {{k_Outside, 1}, {k_Outside, 2}, {1, 2}};
+    DREAM3D_REQUIRE(patchSet == expected)
+
+    // Union of the faces of a patch across their shared edges
+    std::vector<size_t> parents(numTriangles);
+    std::iota(parents.begin(), parents.end(), 0);
+    auto find = [&parents](size_t t) {
+      while(parents[t] != t)
+      {
+        parents[t] = parents[parents[t]];
+        t = parents[t];
+      }
+      return t;
+    };
+    std::map<std::pair<MeshIndexType, MeshIndexType>, std::vector<size_t>> edgeFaces;
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      for(size_t c = 0; c < 3; c++)
+      {
+        MeshIndexType u = triangles[3 * t + c];
+        MeshIndexType w = triangles[3 * t + (c + 1) % 3];
+        edgeFaces[std::make_pair(std::min(u, w), std::max(u, w))].push_back(t);
+      }
+    }
+    for(const auto& edge : edgeFaces)
+    {
+      for(size_t s : edge.second)
+      {
+        if(patches[s] == patches[edge.second.front()])
+        {
+          parents[find(s)] = find(edge.second.front());
+        }
+      }
+    }
+    std::map<std::pair<int32_t, int32_t>, std::set<size_t>> components;
+    for(size_t t = 0; t < numTriangles; t++)
+    {
+      components[patches[t]].insert(find(t));
+    }
+    for(const auto& patch : components)
+    {
+      DREAM3D_REQUIRE_EQUAL(patch.second.size(), 1)
+    }
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestWeldAndClean()
+  {
+    SurfaceMesh mesh = CreateTwoGrainBox();
+    size_t numBoxTriangles = mesh.labels.size() / 2;
+
+    // A copy of the first triangle that only matches it after welding, and a triangle without area
+    float shifted[3][3];
+    for(size_t c = 0; c < 9; c++)
+    {
+      shifted[c / 3][c % 3] = mesh.vertices[c] + 0.002f;
+    }
+    mesh.addTriangle(shifted[0], shifted[1], shifted[2], 1, k_Outside);
+    const float line[3][3] = {{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 0.25f}, {0.0f, 0.0f, 0.5f}};
+    mesh.addTriangle(line[0], line[1], line[2], 1, k_Outside);
+
+    size_t numTriangles = mesh.labels.size() / 2;
+    size_t numVertices = mesh.vertices.size() / 3;
+    SimulationIO::SurfaceMeshPreconditioner preconditioner;
+    preconditioner.setWeldTolerance(0.01f);
+    preconditioner.run(mesh.vertices.data(), numVertices, mesh.triangles.data(), mesh.labels.data(), numTriangles);
+
+    // The lattice points on the surface of the 2 x 1 x 1 box plus those inside the wall
+    const size_t n = static_cast<size_t>(k_Cells);
+    size_t numLatticeVertices = (2 * n + 1) * (n + 1) * (n + 1) - (2 * n - 1) * (n - 1) * (n - 1) + (n - 1) * (n - 1);
+    DREAM3D_REQUIRE_EQUAL(preconditioner.getVertices().size(), 3 * numLatticeVertices)
+    DREAM3D_REQUIRE_EQUAL(preconditioner.getNumberOfWeldedVertices(), numVertices - numLatticeVertices)
+    DREAM3D_REQUIRE_EQUAL(preconditioner.getNumberOfRemovedTriangles(), 2)
+    DREAM3D_REQUIRE_EQUAL(preconditioner.getNumberOfCollapsedEdges(), 0)
+    DREAM3D_REQUIRE_EQUAL(preconditioner.getTriangles().size(), 3 * numBoxTriangles)
+    DREAM3D_REQUIRE_EQUAL(preconditioner.getFaceLabels().size(), 2 * numBoxTriangles)
+
+    CheckGrainsClosed(preconditioner.getTriangles(), preconditioner.getFaceLabels());
+    CheckPatches(preconditioner.getTriangles(), preconditioner.getFaceLabels());
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestDecimate()
+  {
+    SurfaceMesh mesh = CreateTwoGrainBox();
+    size_t numTriangles = mesh.labels.size() / 2;
+    const float targetEdgeLength = 0.6f;
+
+    SimulationIO::SurfaceMeshPreconditioner preconditioner;
+    preconditioner.setTargetEdgeLength(targetEdgeLength);
+    preconditioner.run(mesh.vertices.data(), mesh.vertices.size() / 3, mesh.triangles.data(), mesh.labels.data(), numTriangles);
+
+    const std::vector<float>& vertices = preconditioner.getVertices();
+    const std::vector<MeshIndexType>& triangles = preconditioner.getTriangles();
+    const std::vector<int32_t>& labels = preconditioner.getFaceLabels();
+    DREAM3D_REQUIRE(preconditioner.getNumberOfCollapsedEdges() > 0)
+    DREAM3D_REQUIRE(triangles.size() < 3 * numTriangles)
+    DREAM3D_REQUIRE_EQUAL(labels.size() * 3, triangles.size() * 2)
+
+    CheckGrainsClosed(triangles, labels);
+    CheckPatches(triangles, labels);
+
+    std::vector<char> onWall(vertices.size() / 3, 0);
+    std::vector<char> onOutside(vertices.size() / 3, 0);
+    for(size_t t = 0; t < triangles.size() / 3; t++)
+    {
+      bool wall = (labels[2 * t] != k_Outside && labels[2 * t + 1] != k_Outside);
+      for(size_t c = 0; c < 3; c++)
+      {
+        MeshIndexType v = triangles[3 * t + c];
+        (wall ? onWall : onOutside)[v] = 1;
+
+        // No collapse makes an edge longer than the target
+        const float* p = vertices.data() + 3 * v;
+        const float* q = vertices.data() + 3 * triangles[3 * t + (c + 1) % 3];
+        float length2 = (p[0] - q[0]) * (p[0] - q[0]) + (p[1] - q[1]) * (p[1] - q[1]) + (p[2] - q[2]) * (p[2] - q[2]);
+        DREAM3D_REQUIRE(length2 <= targetEdgeLength * targetEdgeLength)
+      }
+    }
+
+    // Vertices on the curve between the wall and the outside only slid along it: they are still on the square
+    // x = 1 where the wall meets the outside of the box
+    size_t numCurveVertices = 0;
+    for(size_t v = 0; v < onWall.size(); v++)
+    {
+      if(onWall[v] == 0 || onOutside[v] == 0)
+      {
+        continue;
+      }
+      const float* p = vertices.data() + 3 * v;
+      DREAM3D_REQUIRE_EQUAL(p[0], 1.0f)
+      DREAM3D_REQUIRE(p[1] == 0.0f || p[1] == 1.0f || p[2] == 0.0f || p[2] == 1.0f)
+      numCurveVertices++;
+    }
+    DREAM3D_REQUIRE(numCurveVertices >= 3)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestWeldAndClean())
+    DREAM3D_REGISTER_TEST(TestDecimate())
+  }
+
+private:
+};
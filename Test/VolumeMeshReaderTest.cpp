@@ -0,0 +1,366 @@
+// -----------------------------------------------------------------------------
+// Insert your license & copyright information here
+// -----------------------------------------------------------------------------
+#pragma once
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "SIMPLib/SIMPLib.h"
+
+#include "UnitTestSupport.hpp"
+
+#include "SimulationIO/SimulationIOFilters/util/VolumeMeshReader.h"
+
+#include "SimulationIOTestFileLocations.h"
+
+class VolumeMeshReaderTest
+{
+
+public:
+  VolumeMeshReaderTest() = default;
+  ~VolumeMeshReaderTest() = default;
+  VolumeMeshReaderTest(const VolumeMeshReaderTest&) = delete;            // Copy Constructor
+  VolumeMeshReaderTest(VolumeMeshReaderTest&&) = delete;                 // Move Constructor
+  VolumeMeshReaderTest& operator=(const VolumeMeshReaderTest&) = delete; // Copy Assignment
+  VolumeMeshReaderTest& operator=(VolumeMeshReaderTest&&) = delete;      // Move Assignment
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void RemoveTestFiles()
+  {
+#if REMOVE_TEST_FILES
+    QFile::remove(UnitTest::VolumeMeshReaderTest::NetgenFile);
+    QFile::remove(UnitTest::VolumeMeshReaderTest::GmshAsciiFile);
+    QFile::remove(UnitTest::VolumeMeshReaderTest::GmshBinaryFile);
+#endif
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void WriteFile(const QString& path, const QByteArray& contents)
+  {
+    QFile file(path);
+    DREAM3D_REQUIRE(file.open(QIODevice::WriteOnly))
+    DREAM3D_REQUIRE_EQUAL(file.write(contents), contents.size())
+    file.close();
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  template <typename T>
+  void AppendBinary(QByteArray& bytes, T value)
+  {
+    bytes.append(reinterpret_cast<const char*>(&value), static_cast<int>(sizeof(T)));
+  }
+
+  // -----------------------------------------------------------------------------
+  // Opens and reads a mesh file and checks its size
+  // -----------------------------------------------------------------------------
+  void ReadMesh(const QString& path, size_t numVertices, size_t numTetrahedra, size_t numSkipped, std::vector<float>& vertices, std::vector<MeshIndexType>& tets, std::vector<int32_t>& regions)
+  {
+    SimulationIO::VolumeMeshReader reader;
+    DREAM3D_REQUIRE(reader.open(path))
+    DREAM3D_REQUIRE_EQUAL(reader.getNumberOfVertices(), numVertices)
+    DREAM3D_REQUIRE_EQUAL(reader.getNumberOfTetrahedra(), numTetrahedra)
+    DREAM3D_REQUIRE_EQUAL(reader.getNumberOfSkippedElements(), numSkipped)
+
+    vertices.assign(3 * numVertices, -1.0f);
+    tets.assign(4 * numTetrahedra, 0);
+    regions.assign(numTetrahedra, 0);
+    DREAM3D_REQUIRE(reader.read(vertices.data(), tets.data(), regions.data()))
+    DREAM3D_REQUIRE(reader.getErrorMessage().isEmpty())
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CheckTet(const std::vector<MeshIndexType>& tets, size_t tet, MeshIndexType v0, MeshIndexType v1, MeshIndexType v2, MeshIndexType v3)
+  {
+    DREAM3D_REQUIRE_EQUAL(tets[4 * tet], v0)
+    DREAM3D_REQUIRE_EQUAL(tets[4 * tet + 1], v1)
+    DREAM3D_REQUIRE_EQUAL(tets[4 * tet + 2], v2)
+    DREAM3D_REQUIRE_EQUAL(tets[4 * tet + 3], v3)
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void CheckVertex(const std::vector<float>& vertices, size_t vertex, float x, float y, float z)
+  {
+    DREAM3D_REQUIRE_EQUAL(vertices[3 * vertex], x)
+    DREAM3D_REQUIRE_EQUAL(vertices[3 * vertex + 1], y)
+    DREAM3D_REQUIRE_EQUAL(vertices[3 * vertex + 2], z)
+  }
+
+  // -----------------------------------------------------------------------------
+  // The Gmsh files hold the same five nodes, with the tags 1, 4, 9, 12 and 20, in two entity blocks. The first
+  // block is parametric, so its nodes carry two more coordinates.
+  // -----------------------------------------------------------------------------
+  void CheckGmshVertices(const std::vector<float>& vertices)
+  {
+    // Tags with gaps: the vertices are kept in file order
+    CheckVertex(vertices, 0, 0.0f, 0.0f, 0.0f);
+    CheckVertex(vertices, 1, 1.0f, 0.0f, 0.0f);
+    CheckVertex(vertices, 2, 0.0f, 1.0f, 0.0f);
+    CheckVertex(vertices, 3, 0.0f, 0.0f, 1.0f);
+    CheckVertex(vertices, 4, 1.0f, 1.0f, 1.0f);
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReadNetgen()
+  {
+    // A prism between the tetrahedra, which is skipped, and a second order tetrahedron of which only the corners are kept
+    WriteFile(UnitTest::VolumeMeshReaderTest::NetgenFile, "mesh3d\n"
+                                                          "dimension\n"
+                                                          "3\n"
+                                                          "geomtype\n"
+                                                          "0\n"
+                                                          "\n"
+                                                          "# surfnr    bcnr   domin  domout      np      p1      p2      p3\n"
+                                                          "surfaceelements\n"
+                                                          "1\n"
+                                                          "1 1 2 0 3 1 2 3\n"
+                                                          "\n"
+                                                          "#  matnr      np      p1      p2      p3      p4\n"
+                                                          "volumeelements\n"
+                                                          "3\n"
+                                                          "2 4 1 2 3 4\n"
+                                                          "1 6 1 2 3 4 5 6\n"
+                                                          "3 10 2 3 4 5 1 6 1 6 1 6\n"
+                                                          "\n"
+                                                          "#          X             Y             Z\n"
+                                                          "points\n"
+                                                          "6\n"
+                                                          "0 0 0\n"
+                                                          "1 0 0\n"
+                                                          "0 1 0\n"
+                                                          "0 0 1\n"
+                                                          "1 1 1\n"
+                                                          "2 2 2\n"
+                                                          "\n"
+                                                          "endmesh\n");
+
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> tets;
+    std::vector<int32_t> regions;
+    ReadMesh(UnitTest::VolumeMeshReaderTest::NetgenFile, 6, 2, 1, vertices, tets, regions);
+
+    CheckVertex(vertices, 0, 0.0f, 0.0f, 0.0f);
+    CheckVertex(vertices, 4, 1.0f, 1.0f, 1.0f);
+    CheckVertex(vertices, 5, 2.0f, 2.0f, 2.0f);
+    CheckTet(tets, 0, 0, 1, 2, 3);
+    CheckTet(tets, 1, 1, 2, 3, 4);
+    DREAM3D_REQUIRE_EQUAL(regions[0], 2)
+    DREAM3D_REQUIRE_EQUAL(regions[1], 3)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReadGmshAscii()
+  {
+    // An $Entities section that is skipped, a triangle that is ignored and a prism that is skipped
+    WriteFile(UnitTest::VolumeMeshReaderTest::GmshAsciiFile, "$MeshFormat\n"
+                                                             "4.1 0 8\n"
+                                                             "$EndMeshFormat\n"
+                                                             "$Entities\n"
+                                                             "0 0 1 1\n"
+                                                             "1 0 0 0 1 1 0 0\n"
+                                                             "7 0 0 0 1 1 1 1 1 0\n"
+                                                             "$EndEntities\n"
+                                                             "$Nodes\n"
+                                                             "2 5 1 20\n"
+                                                             "2 1 1 2\n"
+                                                             "1\n"
+                                                             "4\n"
+                                                             "0 0 0 0 0\n"
+                                                             "1 0 0 1 0\n"
+                                                             "3 7 0 3\n"
+                                                             "9\n"
+                                                             "12\n"
+                                                             "20\n"
+                                                             "0 1 0\n"
+                                                             "0 0 1\n"
+                                                             "1 1 1\n"
+                                                             "$EndNodes\n"
+                                                             "$Elements\n"
+                                                             "3 4 1 4\n"
+                                                             "2 1 2 1\n"
+                                                             "1 1 4 9\n"
+                                                             "3 7 4 2\n"
+                                                             "2 1 4 9 12\n"
+                                                             "3 4 12 20 9\n"
+                                                             "3 7 6 1\n"
+                                                             "4 1 4 9 12 20 9\n"
+                                                             "$EndElements\n");
+
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> tets;
+    std::vector<int32_t> regions;
+    ReadMesh(UnitTest::VolumeMeshReaderTest::GmshAsciiFile, 5, 2, 1, vertices, tets, regions);
+
+    CheckGmshVertices(vertices);
+    CheckTet(tets, 0, 0, 1, 2, 3);
+    CheckTet(tets, 1, 1, 3, 4, 2);
+    DREAM3D_REQUIRE_EQUAL(regions[0], 7)
+    DREAM3D_REQUIRE_EQUAL(regions[1], 7)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReadGmshBinary()
+  {
+    QByteArray bytes("$MeshFormat\n4.1 1 8\n");
+    AppendBinary<int32_t>(bytes, 1);
+    bytes += "\n$EndMeshFormat\n$Nodes\n";
+    for(uint64_t value : {2, 5, 1, 20})
+    {
+      AppendBinary<uint64_t>(bytes, value);
+    }
+    // entityDim entityTag parametric numNodesInBlock, the tags, then x y z (u v) per node
+    AppendBinary<int32_t>(bytes, 2);
+    AppendBinary<int32_t>(bytes, 1);
+    AppendBinary<int32_t>(bytes, 1);
+    AppendBinary<uint64_t>(bytes, 2);
+    for(uint64_t tag : {1, 4})
+    {
+      AppendBinary<uint64_t>(bytes, tag);
+    }
+    for(double value : {0.0, 0.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 1.0, 0.0})
+    {
+      AppendBinary<double>(bytes, value);
+    }
+    AppendBinary<int32_t>(bytes, 3);
+    AppendBinary<int32_t>(bytes, 7);
+    AppendBinary<int32_t>(bytes, 0);
+    AppendBinary<uint64_t>(bytes, 3);
+    for(uint64_t tag : {9, 12, 20})
+    {
+      AppendBinary<uint64_t>(bytes, tag);
+    }
+    for(double value : {0.0, 1.0, 0.0, 0.0, 0.0, 1.0, 1.0, 1.0, 1.0})
+    {
+      AppendBinary<double>(bytes, value);
+    }
+    bytes += "\n$EndNodes\n$Elements\n";
+
+    // A triangle, a linear tetrahedron in volume 7, a second order tetrahedron and a prism in volume 8
+    for(uint64_t value : {4, 4, 1, 4})
+    {
+      AppendBinary<uint64_t>(bytes, value);
+    }
+    struct Block
+    {
+      int32_t dim;
+      int32_t tag;
+      int32_t type;
+      std::vector<uint64_t> record;
+    };
+    std::vector<Block> blocks = {{2, 1, 2, {1, 1, 4, 9}},
+                                 {3, 7, 4, {2, 1, 4, 9, 12}},
+                                 {3, 8, 11, {3, 4, 12, 20, 9, 1, 1, 1, 1, 1, 1}},
+                                 {3, 8, 6, {4, 1, 4, 9, 12, 20, 9}}};
+    for(const Block& block : blocks)
+    {
+      AppendBinary<int32_t>(bytes, block.dim);
+      AppendBinary<int32_t>(bytes, block.tag);
+      AppendBinary<int32_t>(bytes, block.type);
+      AppendBinary<uint64_t>(bytes, 1);
+      for(uint64_t value : block.record)
+      {
+        AppendBinary<uint64_t>(bytes, value);
+      }
+    }
+    bytes += "\n$EndElements\n";
+    WriteFile(UnitTest::VolumeMeshReaderTest::GmshBinaryFile, bytes);
+
+    std::vector<float> vertices;
+    std::vector<MeshIndexType> tets;
+    std::vector<int32_t> regions;
+    ReadMesh(UnitTest::VolumeMeshReaderTest::GmshBinaryFile, 5, 2, 1, vertices, tets, regions);
+
+    CheckGmshVertices(vertices);
+    CheckTet(tets, 0, 0, 1, 2, 3);
+    CheckTet(tets, 1, 1, 3, 4, 2);
+    DREAM3D_REQUIRE_EQUAL(regions[0], 7)
+    DREAM3D_REQUIRE_EQUAL(regions[1], 8)
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  int TestReadErrors()
+  {
+    SimulationIO::VolumeMeshReader reader;
+    DREAM3D_REQUIRE(!reader.open(UnitTest::VolumeMeshReaderTest::NetgenFile + ".txt"))
+    DREAM3D_REQUIRE(!reader.getErrorMessage().isEmpty())
+
+    // Version 2 of the Gmsh format
+    WriteFile(UnitTest::VolumeMeshReaderTest::GmshAsciiFile, "$MeshFormat\n2.2 0 8\n$EndMeshFormat\n");
+    DREAM3D_REQUIRE(!reader.open(UnitTest::VolumeMeshReaderTest::GmshAsciiFile))
+    DREAM3D_REQUIRE(!reader.getErrorMessage().isEmpty())
+
+    // An element that refers to a node tag in the gap
+    WriteFile(UnitTest::VolumeMeshReaderTest::GmshAsciiFile, "$MeshFormat\n"
+                                                             "4.1 0 8\n"
+                                                             "$EndMeshFormat\n"
+                                                             "$Nodes\n"
+                                                             "1 4 1 5\n"
+                                                             "3 1 0 4\n"
+                                                             "1\n"
+                                                             "2\n"
+                                                             "3\n"
+                                                             "5\n"
+                                                             "0 0 0\n"
+                                                             "1 0 0\n"
+                                                             "0 1 0\n"
+                                                             "0 0 1\n"
+                                                             "$EndNodes\n"
+                                                             "$Elements\n"
+                                                             "1 1 1 1\n"
+                                                             "3 1 4 1\n"
+                                                             "1 1 2 3 4\n"
+                                                             "$EndElements\n");
+    DREAM3D_REQUIRE(reader.open(UnitTest::VolumeMeshReaderTest::GmshAsciiFile))
+    std::vector<float> vertices(3 * reader.getNumberOfVertices());
+    std::vector<MeshIndexType> tets(4 * reader.getNumberOfTetrahedra());
+    std::vector<int32_t> regions(reader.getNumberOfTetrahedra());
+    DREAM3D_REQUIRE(!reader.read(vertices.data(), tets.data(), regions.data()))
+    DREAM3D_REQUIRE(!reader.getErrorMessage().isEmpty())
+
+    return EXIT_SUCCESS;
+  }
+
+  // -----------------------------------------------------------------------------
+  //
+  // -----------------------------------------------------------------------------
+  void operator()()
+  {
+    int err = EXIT_SUCCESS;
+
+    DREAM3D_REGISTER_TEST(TestReadNetgen())
+    DREAM3D_REGISTER_TEST(TestReadGmshAscii())
+    DREAM3D_REGISTER_TEST(TestReadGmshBinary())
+    DREAM3D_REGISTER_TEST(TestReadErrors())
+
+    DREAM3D_REGISTER_TEST(RemoveTestFiles())
+  }
+
+private:
+};